@@ -1,107 +1,261 @@
 #include "apu.h"
+#include <algorithm>
 
-APU::APU()
+void APU::Cycle(uint8_t cycles)
 {
-    this->channel1 = new Channel1();
-    this->channel2 = new Channel2();
-    this->channel3 = new Channel3();
-    this->channel4 = new Channel4();
+    if (!enabled)
+        return;
+
+    // the frame sequencer counts every cycle, lengths, envelopes, sweep and NR52 step on the
+    // same cycles at any sample rate and whether or not the apu is muted
+    this->frame_counter += cycles;
+    if (this->frame_counter >= APU_FRAME_RATE)
+    {
+        this->frame_counter -= APU_FRAME_RATE;
+        TickFrame();
+    }
+
+    this->sample_cycles += cycles;
+    this->sample_phase += cycles * this->sample_rate;
+    if (this->sample_phase >= CLOCK_RATE)
+    {
+        this->sample_phase -= CLOCK_RATE;
+
+        const uint16_t elapsed = this->sample_cycles;
+        this->sample_cycles = 0;
+
+        if (this->muted) [[unlikely]]
+            return;
+
+        this->channel1.Tick(elapsed);
+        this->channel2.Tick(elapsed);
+        this->channel3.Tick(elapsed);
+        this->channel4.Tick(elapsed);
+
+        CaptureSample();
+    }
 }
 
-void APU::Cycle(uint8_t cycles)
+void APU::SetSampleRate(uint32_t rate)
 {
-    if (!enabled)
+    this->sample_rate = std::clamp<uint32_t>(rate, APU_MIN_SAMPLE_RATE, APU_MAX_SAMPLE_RATE);
+    this->sample_phase = 0;
+
+#ifdef PESTO_GB_FIXED_AUDIO
+    this->dc_block_alpha = static_cast<int32_t>(APU_DC_BLOCK_ALPHA * APU_DEFAULT_SAMPLE_RATE / this->sample_rate);
+#endif
+}
+
+void APU::CaptureSample()
+{
+    const uint16_t i = this->block_length;
+
+#ifdef PESTO_GB_FIXED_AUDIO
+    // twice the output against the volume is the offset from the middle in half steps,
+    // the wave channel's middle is the sum of its samples over their count
+    constexpr int half_step = APU_FIXED_LEVEL_SCALE / 2;
+    constexpr int wave_sum_scale = APU_FIXED_LEVEL_SCALE / CH3_WAVE_SAMPLE_COUNT;
+
+    this->channel_levels[0][i] = channel1.IsDACEnabled()
+                                     ? static_cast<int16_t>((channel1.output * 2 - channel1.volume) * half_step)
+                                     : 0;
+    this->channel_levels[1][i] = channel2.IsDACEnabled()
+                                     ? static_cast<int16_t>((channel2.output * 2 - channel2.volume) * half_step)
+                                     : 0;
+    this->channel_levels[2][i] = channel3.IsDACEnabled()
+                                     ? static_cast<int16_t>(channel3.output * APU_FIXED_LEVEL_SCALE - channel3.wave_sum * wave_sum_scale)
+                                     : 0;
+    this->channel_levels[3][i] = channel4.IsDACEnabled()
+                                     ? static_cast<int16_t>((channel4.output * 2 - channel4.volume) * half_step)
+                                     : 0;
+#else
+    this->channel_levels[0][i] = channel1.IsDACEnabled()
+                                     ? static_cast<float>(channel1.output) - channel1.volume * 0.5f
+                                     : 0.0f;
+    this->channel_levels[1][i] = channel2.IsDACEnabled()
+                                     ? static_cast<float>(channel2.output) - channel2.volume * 0.5f
+                                     : 0.0f;
+    this->channel_levels[2][i] = channel3.IsDACEnabled()
+                                     ? static_cast<float>(channel3.output) - channel3.dc_offset
+                                     : 0.0f;
+    this->channel_levels[3][i] = channel4.IsDACEnabled()
+                                     ? static_cast<float>(channel4.output) - channel4.volume * 0.5f
+                                     : 0.0f;
+#endif
+
+    if (++this->block_length == APU_MIX_BLOCK_SIZE)
     {
-        this->sample_left = 0.0f;
-        this->sample_right = 0.0f;
-        return;
+        MixPending();
+        this->ready_for_samples = true;
+    }
+}
+
+#ifdef PESTO_GB_FIXED_AUDIO
+static AudioSample BlockDC(int32_t sample, int32_t& dc_level, int32_t alpha)
+{
+    const int32_t output = sample - (dc_level >> APU_DC_BLOCK_SHIFT);
+    const int64_t error = (static_cast<int64_t>(sample) << APU_DC_BLOCK_SHIFT) - dc_level;
+    dc_level += static_cast<int32_t>((error * alpha) >> APU_DC_BLOCK_SHIFT);
+
+    return static_cast<AudioSample>(std::clamp(output, AUDIO_SAMPLE_MIN, AUDIO_SAMPLE_MAX));
+}
+
+void APU::MixPending()
+{
+    PROFILE_SCOPE(memory->stats, TIMER_APU_MIX);
+
+    const uint16_t begin = this->mixed_length;
+    const uint16_t end = this->block_length;
+    PROFILE_ADD(memory->stats, COUNTER_SAMPLES, end - begin);
+
+    for (uint16_t i = begin; i < end; i++)
+    {
+        this->sum_left[i] = 0;
+        this->sum_right[i] = 0;
+    }
+
+    for (int channel = 0; channel < APU_CHANNEL_COUNT; channel++)
+    {
+        const int16_t* levels = this->channel_levels[channel];
+        const int32_t left_gain = this->gain_left[channel];
+        const int32_t right_gain = this->gain_right[channel];
+
+        for (uint16_t i = begin; i < end; i++)
+        {
+            this->sum_left[i] += levels[i] * left_gain;
+            this->sum_right[i] += levels[i] * right_gain;
+        }
+    }
+
+    // the filter carries from one sample to the next, this part stays serial
+    for (uint16_t i = begin; i < end; i++)
+    {
+        this->mix_left[i] = BlockDC(this->sum_left[i] >> APU_FIXED_GAIN_SHIFT, this->dc_level_left, this->dc_block_alpha);
+        this->mix_right[i] = BlockDC(this->sum_right[i] >> APU_FIXED_GAIN_SHIFT, this->dc_level_right, this->dc_block_alpha);
+    }
+
+    this->mixed_length = end;
+}
+
+void APU::UpdateGains()
+{
+    const uint8_t vol = *NR50;
+    const uint8_t panning = *NR51;
+
+    const int32_t master_left = ((vol & APU_NR50_LEFT_VOLUME_MASK) >> 4) * APU_FIXED_GAIN;
+    const int32_t master_right = (vol & APU_NR50_RIGHT_VOLUME_MASK) * APU_FIXED_GAIN;
+
+    const uint8_t left_masks[APU_CHANNEL_COUNT] = {
+        APU_NR51_CH1_LEFT_MASK, APU_NR51_CH2_LEFT_MASK, APU_NR51_CH3_LEFT_MASK, APU_NR51_CH4_LEFT_MASK
+    };
+    const uint8_t right_masks[APU_CHANNEL_COUNT] = {
+        APU_NR51_CH1_RIGHT_MASK, APU_NR51_CH2_RIGHT_MASK, APU_NR51_CH3_RIGHT_MASK, APU_NR51_CH4_RIGHT_MASK
+    };
+
+    for (int channel = 0; channel < APU_CHANNEL_COUNT; channel++)
+    {
+        this->gain_left[channel] = (panning & left_masks[channel]) ? master_left : 0;
+        this->gain_right[channel] = (panning & right_masks[channel]) ? master_right : 0;
     }
+}
+#else
+void APU::MixPending()
+{
+    PROFILE_SCOPE(memory->stats, TIMER_APU_MIX);
+
+    const uint16_t begin = this->mixed_length;
+    const uint16_t end = this->block_length;
+    PROFILE_ADD(memory->stats, COUNTER_SAMPLES, end - begin);
 
-    this->sample_counter += cycles;
-    if (this->sample_counter >= APU_CYCLES_PER_SAMPLE)
+    for (uint16_t i = begin; i < end; i++)
     {
-        this->sample_counter -= APU_CYCLES_PER_SAMPLE;
-        
-        this->frame_counter += APU_CYCLES_PER_SAMPLE;
-        if (this->frame_counter >= APU_FRAME_RATE)
+        this->mix_left[i] = 0.0f;
+        this->mix_right[i] = 0.0f;
+    }
+
+    // a channel panned away has a gain of zero, adding its product changes nothing
+    for (int channel = 0; channel < APU_CHANNEL_COUNT; channel++)
+    {
+        const float* levels = this->channel_levels[channel];
+        const float left_gain = this->gain_left[channel];
+        const float right_gain = this->gain_right[channel];
+
+        for (uint16_t i = begin; i < end; i++)
         {
-            this->frame_counter -= APU_FRAME_RATE;
-            TickFrame();
+            this->mix_left[i] += levels[i] * left_gain;
+            this->mix_right[i] += levels[i] * right_gain;
         }
+    }
 
-        this->channel1->Tick(APU_CYCLES_PER_SAMPLE);
-        this->channel2->Tick(APU_CYCLES_PER_SAMPLE);
-        this->channel3->Tick(APU_CYCLES_PER_SAMPLE);
-        this->channel4->Tick(APU_CYCLES_PER_SAMPLE);
+    for (uint16_t i = begin; i < end; i++)
+    {
+        const float left = this->mix_left[i] * INV_CHANNEL_COUNT * this->master_left * INV_VOLUME_DIVISOR;
+        const float right = this->mix_right[i] * INV_CHANNEL_COUNT * this->master_right * INV_VOLUME_DIVISOR;
 
-        MixSample();
+        this->mix_left[i] = left < -1.0f ? -1.0f : (left > 1.0f ? 1.0f : left);
+        this->mix_right[i] = right < -1.0f ? -1.0f : (right > 1.0f ? 1.0f : right);
     }
+
+    this->mixed_length = end;
 }
 
-void APU::MixSample()
+void APU::UpdateGains()
 {
     const uint8_t vol = *NR50;
     const uint8_t panning = *NR51;
-    const float left_volume = static_cast<float>((vol & APU_NR50_LEFT_VOLUME_MASK) >> 4);
-    const float right_volume = static_cast<float>(vol & APU_NR50_RIGHT_VOLUME_MASK);
-
-    const float ch1 = channel1->IsDACEnabled()
-                          ? (static_cast<float>(channel1->output) - channel1->volume * 0.5f) * INV_MAX_VOLUME
-                          : 0.0f;
-    const float ch2 = channel2->IsDACEnabled()
-                          ? (static_cast<float>(channel2->output) - channel2->volume * 0.5f) * INV_MAX_VOLUME
-                          : 0.0f;
-    const float ch3 = channel3->IsDACEnabled()
-                          ? (static_cast<float>(channel3->output) - channel3->dc_offset) * INV_MAX_VOLUME
-                          : 0.0f;
-    const float ch4 = channel4->IsDACEnabled()
-                          ? (static_cast<float>(channel4->output) - channel4->volume * 0.5f) * INV_MAX_VOLUME
-                          : 0.0f;
-
-    float left = 0.0f, right = 0.0f;
-    if (panning & APU_NR51_CH1_LEFT_MASK) left += ch1;
-    if (panning & APU_NR51_CH1_RIGHT_MASK) right += ch1;
-    if (panning & APU_NR51_CH2_LEFT_MASK) left += ch2;
-    if (panning & APU_NR51_CH2_RIGHT_MASK) right += ch2;
-    if (panning & APU_NR51_CH3_LEFT_MASK) left += ch3;
-    if (panning & APU_NR51_CH3_RIGHT_MASK) right += ch3;
-    if (panning & APU_NR51_CH4_LEFT_MASK) left += ch4;
-    if (panning & APU_NR51_CH4_RIGHT_MASK) right += ch4;
-
-    left = left * INV_CHANNEL_COUNT * left_volume * INV_VOLUME_DIVISOR;
-    right = right * INV_CHANNEL_COUNT * right_volume * INV_VOLUME_DIVISOR;
-
-    this->sample_left = left < -1.0f ? -1.0f : (left > 1.0f ? 1.0f : left);
-    this->sample_right = right < -1.0f ? -1.0f : (right > 1.0f ? 1.0f : right);
-    this->ready_for_samples = true;
+
+    this->master_left = static_cast<float>((vol & APU_NR50_LEFT_VOLUME_MASK) >> 4);
+    this->master_right = static_cast<float>(vol & APU_NR50_RIGHT_VOLUME_MASK);
+
+    const uint8_t left_masks[APU_CHANNEL_COUNT] = {
+        APU_NR51_CH1_LEFT_MASK, APU_NR51_CH2_LEFT_MASK, APU_NR51_CH3_LEFT_MASK, APU_NR51_CH4_LEFT_MASK
+    };
+    const uint8_t right_masks[APU_CHANNEL_COUNT] = {
+        APU_NR51_CH1_RIGHT_MASK, APU_NR51_CH2_RIGHT_MASK, APU_NR51_CH3_RIGHT_MASK, APU_NR51_CH4_RIGHT_MASK
+    };
+
+    for (int channel = 0; channel < APU_CHANNEL_COUNT; channel++)
+    {
+        this->gain_left[channel] = (panning & left_masks[channel]) ? INV_MAX_VOLUME : 0.0f;
+        this->gain_right[channel] = (panning & right_masks[channel]) ? INV_MAX_VOLUME : 0.0f;
+    }
+}
+#endif
+
+size_t APU::TakeSamples(const AudioSample*& left, const AudioSample*& right)
+{
+    MixPending();
+
+    left = this->mix_left;
+    right = this->mix_right;
+
+    const size_t count = this->block_length;
+    this->block_length = 0;
+    this->mixed_length = 0;
+    this->ready_for_samples = false;
+    return count;
 }
 
 void APU::AttachMemory(Memory* mem)
 {
     memory = mem;
-    this->channel1->AttachMemory(mem);
-    this->channel2->AttachMemory(mem);
-    this->channel3->AttachMemory(mem);
-    this->channel4->AttachMemory(mem);
+    this->channel1.AttachMemory(mem);
+    this->channel2.AttachMemory(mem);
+    this->channel3.AttachMemory(mem);
+    this->channel4.AttachMemory(mem);
 
-    mem->RegisterIOHandler(0x10, 0x3F, this, &APU::APURead, &APU::APUWrite);
+    mem->RegisterIOHandler<&APU::APURead, &APU::APUWrite>(0x10, 0x3F, this);
 
     NR50 = mem->PtrIO(APU_NR50_ADDR);
     NR51 = mem->PtrIO(APU_NR51_ADDR);
 }
 
-void APU::GetSamples(float& left, float& right) const
-{
-    left = sample_left;
-    right = sample_right;
-}
-
 void APU::TickFrame()
 {
-    this->channel1->TickFrame(frame_step);
-    this->channel2->TickFrame(frame_step);
-    this->channel3->TickFrame(frame_step);
-    this->channel4->TickFrame(frame_step);
+    this->channel1.TickFrame(frame_step);
+    this->channel2.TickFrame(frame_step);
+    this->channel3.TickFrame(frame_step);
+    this->channel4.TickFrame(frame_step);
 
     this->frame_step = (this->frame_step + 1) & 7;
 }
@@ -123,10 +277,10 @@ uint8_t APU::APURead(uint8_t* io, uint16_t offset)
     {
         uint8_t base = 0x70;
         if (enabled) base |= 0x80;
-        if (channel1->IsEnabled()) base |= 0b0001;
-        if (channel2->IsEnabled()) base |= 0b0010;
-        if (channel3->IsEnabled()) base |= 0b0100;
-        if (channel4->IsEnabled()) base |= 0b1000;
+        if (channel1.IsEnabled()) base |= 0b0001;
+        if (channel2.IsEnabled()) base |= 0b0010;
+        if (channel3.IsEnabled()) base |= 0b0100;
+        if (channel4.IsEnabled()) base |= 0b1000;
         return base;
     }
 
@@ -146,13 +300,15 @@ void APU::APUWrite(uint8_t* io, uint16_t offset, uint8_t value)
         }
         else if (!enable && enabled)
         {
+            MixPending();
             enabled = false;
-            channel1->Reset();
-            channel2->Reset();
-            channel3->Reset();
-            channel4->Reset();
+            channel1.Reset();
+            channel2.Reset();
+            channel3.Reset();
+            channel4.Reset();
             for (uint8_t i = APU_REG_START; i <= APU_REG_END; i++)
                 io[i] = 0x00;
+            UpdateGains();
         }
         return;
     }
@@ -162,19 +318,19 @@ void APU::APUWrite(uint8_t* io, uint16_t offset, uint8_t value)
         switch (offset)
         {
         case CH1_NR11_ADDR:
-            channel1->length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
+            channel1.length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
             io[offset] = value & CH_NRx1_LENGTH_MASK;
             break;
         case CH2_NR21_ADDR:
-            channel2->length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
+            channel2.length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
             io[offset] = value & CH_NRx1_LENGTH_MASK;
             break;
         case CH3_NR31_ADDR:
-            channel3->length_timer = CH_8BIT_LENGTH_MAX - value;
+            channel3.length_timer = CH_8BIT_LENGTH_MAX - value;
             io[offset] = value;
             break;
         case CH4_NR41_ADDR:
-            channel4->length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
+            channel4.length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
             io[offset] = value & CH_NRx1_LENGTH_MASK;
             break;
         }
@@ -185,151 +341,206 @@ void APU::APUWrite(uint8_t* io, uint16_t offset, uint8_t value)
     {
     case CH1_NR10_ADDR:
         {
-            bool old_negate = (*channel1->NR10 & CH1_NR10_SWEEP_DIR_MASK) != 0;
+            bool old_negate = (*channel1.NR10 & CH1_NR10_SWEEP_DIR_MASK) != 0;
             io[offset] = value;
-            bool new_negate = (*channel1->NR10 & CH1_NR10_SWEEP_DIR_MASK) != 0;
-            if (old_negate && !new_negate && channel1->sweep_negate_used)
-                channel1->is_enabled = false;
+            bool new_negate = (*channel1.NR10 & CH1_NR10_SWEEP_DIR_MASK) != 0;
+            if (old_negate && !new_negate && channel1.sweep_negate_used)
+                channel1.is_enabled = false;
             break;
         }
     case CH1_NR11_ADDR:
-        channel1->length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
+        channel1.length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
         break;
     case CH2_NR21_ADDR:
-        channel2->length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
+        channel2.length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
         break;
     case CH3_NR31_ADDR:
-        channel3->length_timer = CH_8BIT_LENGTH_MAX - value;
+        channel3.length_timer = CH_8BIT_LENGTH_MAX - value;
         break;
     case CH4_NR41_ADDR:
-        channel4->length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
+        channel4.length_timer = CH_6BIT_LENGTH_MAX - (value & CH_NRx1_LENGTH_MASK);
         break;
 
     case CH1_NR12_ADDR:
         {
-            uint8_t old_pace = *channel1->NR12 & CH_NRx2_ENV_PACE_MASK;
-            bool old_increase = *channel1->NR12 & CH_NRx2_ENVELOPE_DIR_MASK;
+            uint8_t old_pace = *channel1.NR12 & CH_NRx2_ENV_PACE_MASK;
+            bool old_increase = *channel1.NR12 & CH_NRx2_ENVELOPE_DIR_MASK;
             io[offset] = value;
-            if ((value & CH_NRx2_DAC_MASK) == 0) channel1->is_enabled = false;
-            if (channel1->is_enabled)
+            if ((value & CH_NRx2_DAC_MASK) == 0) channel1.is_enabled = false;
+            if (channel1.is_enabled)
             {
-                if (old_pace == 0 && channel1->is_envelope_alive) channel1->volume++;
-                else if (!old_increase) channel1->volume += 2;
+                if (old_pace == 0 && channel1.is_envelope_alive) channel1.volume++;
+                else if (!old_increase) channel1.volume += 2;
                 if (old_increase != static_cast<bool>(value & CH_NRx2_ENVELOPE_DIR_MASK))
-                    channel1->volume = 16 - channel1->volume;
-                channel1->volume &= 0xF;
+                    channel1.volume = 16 - channel1.volume;
+                channel1.volume &= 0xF;
             }
             break;
         }
     case CH2_NR22_ADDR:
         {
-            uint8_t old_pace = *channel2->NR22 & CH_NRx2_ENV_PACE_MASK;
-            bool old_increase = *channel2->NR22 & CH_NRx2_ENVELOPE_DIR_MASK;
+            uint8_t old_pace = *channel2.NR22 & CH_NRx2_ENV_PACE_MASK;
+            bool old_increase = *channel2.NR22 & CH_NRx2_ENVELOPE_DIR_MASK;
             io[offset] = value;
-            if ((value & CH_NRx2_DAC_MASK) == 0) channel2->is_enabled = false;
-            if (channel2->is_enabled)
+            if ((value & CH_NRx2_DAC_MASK) == 0) channel2.is_enabled = false;
+            if (channel2.is_enabled)
             {
-                if (old_pace == 0 && channel2->is_envelope_alive) channel2->volume++;
-                else if (!old_increase) channel2->volume += 2;
+                if (old_pace == 0 && channel2.is_envelope_alive) channel2.volume++;
+                else if (!old_increase) channel2.volume += 2;
                 if (old_increase != static_cast<bool>(value & CH_NRx2_ENVELOPE_DIR_MASK))
-                    channel2->volume = 16 - channel2->volume;
-                channel2->volume &= 0xF;
+                    channel2.volume = 16 - channel2.volume;
+                channel2.volume &= 0xF;
             }
             break;
         }
     case CH3_NR30_ADDR:
-        if ((value & CH3_NR30_DAC_MASK) == 0) channel3->is_enabled = false;
+        if ((value & CH3_NR30_DAC_MASK) == 0) channel3.is_enabled = false;
         break;
     case CH4_NR42_ADDR:
         {
-            uint8_t old_pace = *channel4->NR42 & CH_NRx2_ENV_PACE_MASK;
-            bool old_increase = *channel4->NR42 & CH_NRx2_ENVELOPE_DIR_MASK;
+            uint8_t old_pace = *channel4.NR42 & CH_NRx2_ENV_PACE_MASK;
+            bool old_increase = *channel4.NR42 & CH_NRx2_ENVELOPE_DIR_MASK;
             io[offset] = value;
-            if ((value & CH_NRx2_DAC_MASK) == 0) channel4->is_enabled = false;
-            if (channel4->is_enabled)
+            if ((value & CH_NRx2_DAC_MASK) == 0) channel4.is_enabled = false;
+            if (channel4.is_enabled)
             {
-                if (old_pace == 0 && channel4->is_envelope_alive) channel4->volume++;
-                else if (!old_increase) channel4->volume += 2;
+                if (old_pace == 0 && channel4.is_envelope_alive) channel4.volume++;
+                else if (!old_increase) channel4.volume += 2;
                 if (old_increase != static_cast<bool>(value & CH_NRx2_ENVELOPE_DIR_MASK))
-                    channel4->volume = 16 - channel4->volume;
-                channel4->volume &= 0xF;
+                    channel4.volume = 16 - channel4.volume;
+                channel4.volume &= 0xF;
             }
             break;
         }
 
     case CH1_NR14_ADDR:
         {
-            bool old_len_enable = (*channel1->NR14 & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
+            bool old_len_enable = (*channel1.NR14 & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
             bool new_len_enable = (value & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
             bool next_clocks_length = (frame_step & 1) != 0;
             io[offset] = value;
             if (!old_len_enable && new_len_enable && next_clocks_length)
-                channel1->TickLength();
+                channel1.TickLength();
             if (value & CH_NRx4_TRIGGER_MASK)
             {
-                bool length_was_zero = channel1->length_timer == 0;
-                channel1->Trigger();
+                bool length_was_zero = channel1.length_timer == 0;
+                channel1.Trigger();
                 if (new_len_enable && next_clocks_length && length_was_zero)
-                    channel1->TickLength();
+                    channel1.TickLength();
             }
             value &= ~CH_NRx4_TRIGGER_MASK;
             break;
         }
     case CH2_NR24_ADDR:
         {
-            bool old_len_enable = (*channel2->NR24 & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
+            bool old_len_enable = (*channel2.NR24 & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
             bool new_len_enable = (value & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
             bool next_clocks_length = (frame_step & 1) != 0;
             io[offset] = value;
             if (!old_len_enable && new_len_enable && next_clocks_length)
-                channel2->TickLength();
+                channel2.TickLength();
             if (value & CH_NRx4_TRIGGER_MASK)
             {
-                bool length_was_zero = channel2->length_timer == 0;
-                channel2->Trigger();
+                bool length_was_zero = channel2.length_timer == 0;
+                channel2.Trigger();
                 if (new_len_enable && next_clocks_length && length_was_zero)
-                    channel2->TickLength();
+                    channel2.TickLength();
             }
             value &= ~CH_NRx4_TRIGGER_MASK;
             break;
         }
     case CH3_NR34_ADDR:
         {
-            bool old_len_enable = (*channel3->NR34 & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
+            bool old_len_enable = (*channel3.NR34 & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
             bool new_len_enable = (value & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
             bool next_clocks_length = (frame_step & 1) != 0;
             io[offset] = value;
             if (!old_len_enable && new_len_enable && next_clocks_length)
-                channel3->TickLength();
+                channel3.TickLength();
             if (value & CH_NRx4_TRIGGER_MASK)
             {
-                bool length_was_zero = channel3->length_timer == 0;
-                channel3->Trigger();
+                bool length_was_zero = channel3.length_timer == 0;
+                channel3.Trigger();
                 if (new_len_enable && next_clocks_length && length_was_zero)
-                    channel3->TickLength();
+                    channel3.TickLength();
             }
             value &= ~CH_NRx4_TRIGGER_MASK;
             break;
         }
     case CH4_NR44_ADDR:
         {
-            bool old_len_enable = (*channel4->NR44 & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
+            bool old_len_enable = (*channel4.NR44 & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
             bool new_len_enable = (value & CH_NRx4_LENGTH_ENABLE_MASK) != 0;
             bool next_clocks_length = (frame_step & 1) != 0;
             io[offset] = value;
             if (!old_len_enable && new_len_enable && next_clocks_length)
-                channel4->TickLength();
+                channel4.TickLength();
             if (value & CH_NRx4_TRIGGER_MASK)
             {
-                bool length_was_zero = channel4->length_timer == 0;
-                channel4->Trigger();
+                bool length_was_zero = channel4.length_timer == 0;
+                channel4.Trigger();
                 if (new_len_enable && next_clocks_length && length_was_zero)
-                    channel4->TickLength();
+                    channel4.TickLength();
             }
             value &= ~CH_NRx4_TRIGGER_MASK;
             break;
         }
+
+    case APU_NR50_ADDR:
+    case APU_NR51_ADDR:
+        MixPending();
+        io[offset] = value;
+        UpdateGains();
+        break;
+
+    default:
+        if (offset >= CH3_WAVE_RAM_START)
+            channel3.WriteWaveRam(offset - CH3_WAVE_RAM_START, value);
+        break;
     }
 
     io[offset] = value;
 }
+
+void APU::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->enabled);
+    writer.Write(this->sample_phase);
+    writer.Write(this->sample_cycles);
+    writer.Write(this->frame_counter);
+    writer.Write(this->frame_step);
+#ifdef PESTO_GB_FIXED_AUDIO
+    writer.Write(this->dc_level_left);
+    writer.Write(this->dc_level_right);
+#endif
+
+    this->channel1.SaveState(writer);
+    this->channel2.SaveState(writer);
+    this->channel3.SaveState(writer);
+    this->channel4.SaveState(writer);
+}
+
+void APU::LoadState(StateReader& reader)
+{
+    reader.Read(this->enabled);
+    reader.Read(this->sample_phase);
+    reader.Read(this->sample_cycles);
+    reader.Read(this->frame_counter);
+    reader.Read(this->frame_step);
+#ifdef PESTO_GB_FIXED_AUDIO
+    reader.Read(this->dc_level_left);
+    reader.Read(this->dc_level_right);
+#endif
+
+    this->channel1.LoadState(reader);
+    this->channel2.LoadState(reader);
+    this->channel3.LoadState(reader);
+    this->channel4.LoadState(reader);
+
+    // states are taken between frames when the block has been handed over, the gains
+    // follow from the restored registers
+    this->block_length = 0;
+    this->mixed_length = 0;
+    this->ready_for_samples = false;
+    UpdateGains();
+}
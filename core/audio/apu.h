@@ -2,6 +2,7 @@
 
 #include "../memory/memory.h"
 #include "../cpu/cpu.h"
+#include "audio_sample.h"
 #include <cstdint>
 
 #include "channels/channel_1.h"
@@ -9,8 +10,10 @@
 #include "channels/channel_3.h"
 #include "channels/channel_4.h"
 
-#define APU_SAMPLE_RATE 44100
-#define APU_CYCLES_PER_SAMPLE (CLOCK_RATE / APU_SAMPLE_RATE)
+#define APU_DEFAULT_SAMPLE_RATE 44100
+// a sample has to be at least a cpu step apart, Cycle takes at most one per call
+#define APU_MIN_SAMPLE_RATE 8000
+#define APU_MAX_SAMPLE_RATE 96000
 
 #define APU_NR50_ADDR 0x24
 #define APU_NR51_ADDR 0x25
@@ -47,20 +50,49 @@
 #define APU_REG_START 0x10
 #define APU_REG_END 0x26
 
+// samples are mixed this many at a time
+#define APU_MIX_BLOCK_SIZE 64
+
+// fixed point mixing. levels are in 64ths of a volume step, the gain scale takes four channels
+// at full level and master volume 7 to full scale
+#define APU_FIXED_LEVEL_SCALE 64
+#define APU_FIXED_GAIN_SHIFT 14
+#define APU_FIXED_MAX_MASTER_VOLUME 7
+#define APU_FIXED_GAIN ((AUDIO_SAMPLE_MAX << APU_FIXED_GAIN_SHIFT) / \
+                        (APU_CHANNEL_COUNT * CH_MAX_VOLUME * APU_FIXED_LEVEL_SCALE * APU_FIXED_MAX_MASTER_VOLUME))
+
+// the dc blocker follows the output with this weight in 16.16 at the default rate, about 7 Hz
+#define APU_DC_BLOCK_SHIFT 16
+#define APU_DC_BLOCK_ALPHA 69
+
 class APU
 {
 public:
-    APU();
-
     void Cycle(uint8_t cycles);
     void AttachMemory(Memory* mem);
-    void GetSamples(float& left, float& right) const;
+
+    // channels are sampled straight at this rate, a lower one costs less to synthesize
+    void SetSampleRate(uint32_t rate);
+    uint32_t GetSampleRate() const { return this->sample_rate; }
+
+    // registers, lengths, envelopes, sweep and NR52 carry on exactly, only the waveforms and
+    // the mix are skipped and no samples come out
+    void SetMuted(bool muted) { this->muted = muted; }
+
+    // mixes what is left of the block and hands it over, left and right hold the returned
+    // number of samples until the next Cycle. a full block has to be taken before then
+    size_t TakeSamples(const AudioSample*& left, const AudioSample*& right);
+
+    void SaveState(StateWriter& writer) const;
+    void LoadState(StateReader& reader);
 
     bool ready_for_samples = false;
 
 private:
     void TickFrame();
-    void MixSample();
+    void CaptureSample();
+    void MixPending();
+    void UpdateGains();
 
     uint8_t APURead(uint8_t* io, uint16_t offset);
     void APUWrite(uint8_t* io, uint16_t offset, uint8_t value);
@@ -68,18 +100,52 @@ private:
     Memory* memory = nullptr;
 
     bool enabled = false;
-
-    Channel1* channel1 = nullptr;
-    Channel2* channel2 = nullptr;
-    Channel3* channel3 = nullptr;
-    Channel4* channel4 = nullptr;
-
-    uint32_t sample_counter = 0;
+    bool muted = false;
+
+    Channel1 channel1;
+    Channel2 channel2;
+    Channel3 channel3;
+    Channel4 channel4;
+
+    uint32_t sample_rate = APU_DEFAULT_SAMPLE_RATE;
+    // cycles times the sample rate, a sample is due every CLOCK_RATE of it. the spacing
+    // alternates between whole cycle counts and averages out to the exact rate
+    uint32_t sample_phase = 0;
+    uint16_t sample_cycles = 0;
     uint32_t frame_counter = 0;
     uint8_t frame_step = 0;
 
-    float sample_left = 0.0f;
-    float sample_right = 0.0f;
+    // a row per channel with its level for every sample in the block, mixing runs down the
+    // rows and adds them up with the gains
+    uint16_t block_length = 0;
+    uint16_t mixed_length = 0;
+    AudioSample mix_left[APU_MIX_BLOCK_SIZE] = {};
+    AudioSample mix_right[APU_MIX_BLOCK_SIZE] = {};
+
+#ifdef PESTO_GB_FIXED_AUDIO
+    int16_t channel_levels[APU_CHANNEL_COUNT][APU_MIX_BLOCK_SIZE] = {};
+    int32_t sum_left[APU_MIX_BLOCK_SIZE] = {};
+    int32_t sum_right[APU_MIX_BLOCK_SIZE] = {};
+
+    // follow NR51 and NR50 with the master volume folded in, what was captured before a
+    // write is mixed with the old values
+    int32_t gain_left[APU_CHANNEL_COUNT] = {};
+    int32_t gain_right[APU_CHANNEL_COUNT] = {};
+
+    // what the output has settled around in 16.16, taken off so the speaker sees no dc.
+    // the weight is scaled with the sample rate to keep the corner where it is
+    int32_t dc_level_left = 0;
+    int32_t dc_level_right = 0;
+    int32_t dc_block_alpha = APU_DC_BLOCK_ALPHA;
+#else
+    float channel_levels[APU_CHANNEL_COUNT][APU_MIX_BLOCK_SIZE] = {};
+
+    // follow NR51 and NR50, what was captured before a write is mixed with the old values
+    float gain_left[APU_CHANNEL_COUNT] = {};
+    float gain_right[APU_CHANNEL_COUNT] = {};
+    float master_left = 0.0f;
+    float master_right = 0.0f;
+#endif
 
     uint8_t* NR50 = nullptr;
     uint8_t* NR51 = nullptr;
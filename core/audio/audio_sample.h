@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+// a PESTO_GB_FIXED_AUDIO build mixes in integers and hands out int16 samples, otherwise
+// samples are floats in -1 to 1
+#ifdef PESTO_GB_FIXED_AUDIO
+typedef int16_t AudioSample;
+
+#define AUDIO_SAMPLE_MAX 32767
+#define AUDIO_SAMPLE_MIN (-32768)
+
+inline float AudioSampleToFloat(AudioSample sample) { return sample * (1.0f / 32768.0f); }
+#else
+typedef float AudioSample;
+
+inline float AudioSampleToFloat(AudioSample sample) { return sample; }
+#endif
@@ -15,3 +15,15 @@ bool BaseChannel::IsEnabled()
 {
     return this->is_enabled;
 }
+
+void BaseChannel::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->output);
+    writer.Write(this->is_enabled);
+}
+
+void BaseChannel::LoadState(StateReader& reader)
+{
+    reader.Read(this->output);
+    reader.Read(this->is_enabled);
+}
@@ -31,6 +31,9 @@ public:
     uint8_t GetOutput();
     bool IsEnabled();
 
+    virtual void SaveState(StateWriter& writer) const;
+    virtual void LoadState(StateReader& reader);
+
     uint8_t output = 0;
     bool is_enabled = false;
 
@@ -189,3 +189,39 @@ uint16_t Channel1::CalculateSweepPeriod()
 
     return new_period;
 }
+
+void Channel1::SaveState(StateWriter& writer) const
+{
+    BaseChannel::SaveState(writer);
+
+    writer.Write(this->period);
+    writer.Write(this->period_timer);
+    writer.Write(this->duty_type);
+    writer.Write(this->duty_step);
+    writer.Write(this->volume);
+    writer.Write(this->length_timer);
+    writer.Write(this->envelope_timer);
+    writer.Write(this->sweep_enable);
+    writer.Write(this->sweep_negate_used);
+    writer.Write(this->sweep_timer);
+    writer.Write(this->sweep_period);
+    writer.Write(this->is_envelope_alive);
+}
+
+void Channel1::LoadState(StateReader& reader)
+{
+    BaseChannel::LoadState(reader);
+
+    reader.Read(this->period);
+    reader.Read(this->period_timer);
+    reader.Read(this->duty_type);
+    reader.Read(this->duty_step);
+    reader.Read(this->volume);
+    reader.Read(this->length_timer);
+    reader.Read(this->envelope_timer);
+    reader.Read(this->sweep_enable);
+    reader.Read(this->sweep_negate_used);
+    reader.Read(this->sweep_timer);
+    reader.Read(this->sweep_period);
+    reader.Read(this->is_envelope_alive);
+}
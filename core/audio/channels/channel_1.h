@@ -19,6 +19,9 @@ public:
     void TickFrame(uint8_t frame_idx);
     void Reset();
     void AttachMemory(Memory* mem) override;
+
+    void SaveState(StateWriter& writer) const override;
+    void LoadState(StateReader& reader) override;
     bool IsDACEnabled();
 
     void Trigger();
@@ -119,3 +119,31 @@ void Channel2::TickEnvelope()
         }
     }
 }
+
+void Channel2::SaveState(StateWriter& writer) const
+{
+    BaseChannel::SaveState(writer);
+
+    writer.Write(this->period);
+    writer.Write(this->period_timer);
+    writer.Write(this->duty_type);
+    writer.Write(this->duty_step);
+    writer.Write(this->volume);
+    writer.Write(this->length_timer);
+    writer.Write(this->envelope_timer);
+    writer.Write(this->is_envelope_alive);
+}
+
+void Channel2::LoadState(StateReader& reader)
+{
+    BaseChannel::LoadState(reader);
+
+    reader.Read(this->period);
+    reader.Read(this->period_timer);
+    reader.Read(this->duty_type);
+    reader.Read(this->duty_step);
+    reader.Read(this->volume);
+    reader.Read(this->length_timer);
+    reader.Read(this->envelope_timer);
+    reader.Read(this->is_envelope_alive);
+}
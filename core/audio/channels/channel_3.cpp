@@ -1,4 +1,5 @@
 #include "channel_3.h"
+#include <algorithm>
 
 void Channel3::Tick(uint16_t cycles)
 {
@@ -21,8 +22,7 @@ void Channel3::Tick(uint16_t cycles)
         this->wave_step = (this->wave_step + ticks) & 31;
     }
 
-    const uint8_t byte = this->memory->ReadIO(CH3_WAVE_RAM_START + (this->wave_step >> 1));
-    const uint8_t sample = (this->wave_step & 1) ? (byte & 0x0F) : (byte >> 4);
+    const uint8_t sample = this->wave_samples[this->wave_step];
 
     this->output = this->volume == 0 ? 0 : sample >> (this->volume - 1);
 }
@@ -41,6 +41,7 @@ void Channel3::Reset()
     wave_step = 0;
     volume = 0;
     length_timer = 0;
+    wave_sum = 0;
     dc_offset = 0;
 }
 
@@ -74,14 +75,23 @@ void Channel3::Trigger()
 
     this->wave_step = 0;
 
-    float sum = 0.0f;
-    for (int i = 0; i < 16; i++)
-    {
-        const uint8_t byte = this->memory->ReadIO(CH3_WAVE_RAM_START + i);
-        sum += static_cast<float>((byte >> 4) & 0xF);
-        sum += static_cast<float>(byte & 0xF);
-    }
-    this->dc_offset = sum / CH3_WAVE_SAMPLE_COUNT;
+    this->wave_sum = 0;
+    for (const uint8_t sample : this->wave_samples)
+        this->wave_sum += sample;
+    this->dc_offset = static_cast<float>(this->wave_sum) / CH3_WAVE_SAMPLE_COUNT;
+}
+
+void Channel3::WriteWaveRam(uint8_t index, uint8_t value)
+{
+    this->wave_samples[index * 2] = value >> 4;
+    this->wave_samples[index * 2 + 1] = value & 0x0F;
+}
+
+void Channel3::DecodeWaveRam()
+{
+    const uint8_t* wave_ram = this->memory->PtrIO(CH3_WAVE_RAM_START);
+    for (uint8_t i = 0; i <= CH3_WAVE_RAM_END - CH3_WAVE_RAM_START; i++)
+        WriteWaveRam(i, wave_ram[i]);
 }
 
 void Channel3::TickLength()
@@ -97,3 +107,33 @@ void Channel3::TickLength()
             this->is_enabled = false;
     }
 }
+
+void Channel3::SaveState(StateWriter& writer) const
+{
+    BaseChannel::SaveState(writer);
+
+    writer.Write(this->period);
+    writer.Write(this->period_timer);
+    writer.Write(this->wave_step);
+    writer.Write(this->volume);
+    writer.Write(this->length_timer);
+    writer.Write(this->wave_sum);
+}
+
+void Channel3::LoadState(StateReader& reader)
+{
+    BaseChannel::LoadState(reader);
+
+    reader.Read(this->period);
+    reader.Read(this->period_timer);
+    reader.Read(this->wave_step);
+    reader.Read(this->volume);
+    reader.Read(this->length_timer);
+    reader.Read(this->wave_sum);
+
+    this->wave_sum = std::min<uint16_t>(this->wave_sum, CH_MAX_VOLUME * CH3_WAVE_SAMPLE_COUNT);
+    this->dc_offset = static_cast<float>(this->wave_sum) / CH3_WAVE_SAMPLE_COUNT;
+
+    // memory is restored first, the samples follow from its wave ram
+    DecodeWaveRam();
+}
@@ -22,12 +22,18 @@ public:
     void TickFrame(uint8_t frame_idx);
     void Reset();
     void AttachMemory(Memory* mem) override;
+
+    void SaveState(StateWriter& writer) const override;
+    void LoadState(StateReader& reader) override;
     bool IsDACEnabled();
 
     void Trigger();
 
     void TickLength();
 
+    // the apu passes on every wave ram write, ticks only look at the decoded samples
+    void WriteWaveRam(uint8_t index, uint8_t value);
+
     uint8_t* NR30 = nullptr;
     uint8_t* NR31 = nullptr;
     uint8_t* NR32 = nullptr;
@@ -38,9 +44,16 @@ public:
     int16_t period_timer = 0;
 
     uint8_t wave_step = 0;
+    // wave ram split into its 4 bit samples, high nibble first
+    uint8_t wave_samples[CH3_WAVE_SAMPLE_COUNT] = {};
 
     uint8_t volume = 0;
     uint16_t length_timer = 0;
 
-    float dc_offset;
+    // the samples added up at the last trigger and their mean, the wave's middle
+    uint16_t wave_sum = 0;
+    float dc_offset = 0.0f;
+
+private:
+    void DecodeWaveRam();
 };
\ No newline at end of file
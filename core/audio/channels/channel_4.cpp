@@ -132,3 +132,27 @@ void Channel4::TickEnvelope()
         }
     }
 }
+
+void Channel4::SaveState(StateWriter& writer) const
+{
+    BaseChannel::SaveState(writer);
+
+    writer.Write(this->volume);
+    writer.Write(this->length_timer);
+    writer.Write(this->envelope_timer);
+    writer.Write(this->period_timer);
+    writer.Write(this->lfsr);
+    writer.Write(this->is_envelope_alive);
+}
+
+void Channel4::LoadState(StateReader& reader)
+{
+    BaseChannel::LoadState(reader);
+
+    reader.Read(this->volume);
+    reader.Read(this->length_timer);
+    reader.Read(this->envelope_timer);
+    reader.Read(this->period_timer);
+    reader.Read(this->lfsr);
+    reader.Read(this->is_envelope_alive);
+}
@@ -0,0 +1,87 @@
+#include "bench.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+static int64_t bench_now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+BenchRunner::BenchRunner(std::string filter, uint32_t min_time_ms)
+{
+    this->filter = std::move(filter);
+    this->min_time_ns = static_cast<int64_t>(min_time_ms) * 1000000;
+}
+
+void BenchRunner::Run(const std::string& name, const std::string& unit, const BenchFunction& function)
+{
+    if (!this->filter.empty() && name.find(this->filter) == std::string::npos)
+        return;
+
+    // grow the batch until one sample takes a fair share of the time budget
+    const int64_t sample_target_ns = std::max<int64_t>(this->min_time_ns / BENCH_SAMPLE_COUNT, 1);
+    uint64_t iterations = 1;
+
+    while (true)
+    {
+        const int64_t start = bench_now_ns();
+        function(iterations);
+        const int64_t elapsed = bench_now_ns() - start;
+
+        if (elapsed >= sample_target_ns)
+            break;
+
+        if (elapsed <= 0)
+        {
+            iterations *= 16;
+            continue;
+        }
+
+        const double scale = std::clamp(static_cast<double>(sample_target_ns) / elapsed * 1.2, 2.0, 16.0);
+        iterations = static_cast<uint64_t>(iterations * scale);
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.unit = unit;
+
+    std::vector<double> samples;
+    for (int i = 0; i < BENCH_SAMPLE_COUNT; i++)
+    {
+        const int64_t start = bench_now_ns();
+        const uint64_t operations = function(iterations);
+        const int64_t elapsed = bench_now_ns() - start;
+
+        result.operations += operations;
+        samples.push_back(static_cast<double>(elapsed) / std::max<uint64_t>(operations, 1));
+    }
+
+    std::sort(samples.begin(), samples.end());
+    result.median_ns = samples[samples.size() / 2];
+    result.min_ns = samples.front();
+    result.max_ns = samples.back();
+
+    fprintf(stderr, "%-28s %12.2f ns/%-12s (min %.2f, max %.2f)\n",
+            name.c_str(), result.median_ns, unit.c_str(), result.min_ns, result.max_ns);
+
+    this->results.push_back(result);
+}
+
+void BenchRunner::WriteJSON(FILE* file) const
+{
+    fprintf(file, "{\n  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < this->results.size(); i++)
+    {
+        const BenchResult& result = this->results[i];
+        fprintf(file,
+                "    {\"name\": \"%s\", \"unit\": \"%s\", \"operations\": %llu, "
+                "\"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, \"max_ns_per_op\": %.3f, \"ops_per_sec\": %.1f}%s\n",
+                result.name.c_str(), result.unit.c_str(), static_cast<unsigned long long>(result.operations),
+                result.median_ns, result.min_ns, result.max_ns, 1e9 / result.median_ns,
+                i + 1 < this->results.size() ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+}
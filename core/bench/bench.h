@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define BENCH_DEFAULT_MIN_TIME_MS 250
+#define BENCH_SAMPLE_COUNT 5
+
+// runs `iterations` units of work and returns how many operations that was
+typedef std::function<uint64_t(uint64_t iterations)> BenchFunction;
+
+struct BenchResult
+{
+    std::string name;
+    std::string unit;
+    uint64_t operations = 0;
+    double median_ns = 0.0;
+    double min_ns = 0.0;
+    double max_ns = 0.0;
+};
+
+class BenchRunner
+{
+public:
+    BenchRunner(std::string filter, uint32_t min_time_ms);
+
+    void Run(const std::string& name, const std::string& unit, const BenchFunction& function);
+    void WriteJSON(FILE* file) const;
+
+    const std::vector<BenchResult>& Results() const { return results; }
+
+private:
+    std::string filter;
+    int64_t min_time_ns;
+    std::vector<BenchResult> results;
+};
+
+// keeps the optimizer from dropping work whose result is otherwise unused
+template <class T>
+void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile T sink;
+    sink = value;
+#endif
+}
@@ -0,0 +1,230 @@
+#include "bench_roms.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#include "../memory/memory.h"
+
+class RomAssembler
+{
+public:
+    explicit RomAssembler(uint16_t base) : base(base) { code.reserve(BENCH_ROM_SIZE); }
+
+    uint16_t PC() const { return static_cast<uint16_t>(base + code.size()); }
+    void Label(const std::string& name) { labels[name] = PC(); }
+
+    void Bytes(std::initializer_list<uint8_t> bytes) { code.insert(code.end(), bytes); }
+
+    void Word(uint8_t opcode, uint16_t value)
+    {
+        Bytes({opcode, static_cast<uint8_t>(value & 0xFF), static_cast<uint8_t>(value >> 8)});
+    }
+
+    // ld a, value; ldh (reg), a
+    void WriteIO(uint8_t reg, uint8_t value) { Bytes({0x3E, value, 0xE0, reg}); }
+
+    void JumpRelative(uint8_t opcode, const std::string& label)
+    {
+        Bytes({opcode, 0});
+        fixups.push_back({code.size() - 1, label, true});
+    }
+
+    void Jump(uint8_t opcode, const std::string& label)
+    {
+        Bytes({opcode, 0, 0});
+        fixups.push_back({code.size() - 2, label, false});
+    }
+
+    const std::vector<uint8_t>& Finish()
+    {
+        for (const Fixup& fixup : fixups)
+        {
+            const uint16_t target = labels.at(fixup.label);
+            if (fixup.relative)
+            {
+                code[fixup.offset] = static_cast<uint8_t>(target - (base + fixup.offset + 1));
+            }
+            else
+            {
+                code[fixup.offset] = target & 0xFF;
+                code[fixup.offset + 1] = target >> 8;
+            }
+        }
+
+        return code;
+    }
+
+private:
+    struct Fixup
+    {
+        size_t offset;
+        std::string label;
+        bool relative;
+    };
+
+    uint16_t base;
+    std::vector<uint8_t> code;
+    std::vector<Fixup> fixups;
+    std::unordered_map<std::string, uint16_t> labels;
+};
+
+std::vector<uint8_t> BuildBenchRom(bool cgb)
+{
+    std::vector<uint8_t> rom(BENCH_ROM_SIZE, 0);
+
+    // entry points and interrupt vectors, interrupts only wake the main loop
+    rom[0x0000] = 0xC3; rom[0x0001] = 0x50; rom[0x0002] = 0x01;
+    rom[0x0040] = 0xD9;
+    rom[0x0048] = 0xD9;
+    rom[0x0100] = 0x00; rom[0x0101] = 0xC3; rom[0x0102] = 0x50; rom[0x0103] = 0x01;
+
+    const char title[] = "PESTOBENCH";
+    for (size_t i = 0; i < sizeof(title) - 1; i++)
+        rom[HEADER_TITLE_ADDR + i] = title[i];
+
+    rom[HEADER_CGB_FLAG_ADDR] = cgb ? HEADER_CGB_ENHANCED_MASK : 0;
+
+    RomAssembler a(0x150);
+    a.Bytes({0xF3});
+    a.Word(0x31, 0xFFFE);
+    a.WriteIO(IO_ADDR_BOOT, 1);
+    a.WriteIO(0x40, 0);
+
+    // tile data
+    a.Word(0x21, 0x8000); a.Word(0x11, BENCH_ROM_DATA_ADDR); a.Word(0x01, 0x0100);
+    a.Label("tiles");
+    a.Bytes({0x1A, 0x22, 0x13, 0x0B, 0x78, 0xB1});
+    a.JumpRelative(0x20, "tiles");
+
+    // both tile maps
+    a.Word(0x21, 0x9800); a.Word(0x01, 0x0800);
+    a.Label("maps");
+    a.Bytes({0x7D, 0xE6, 0x0F, 0x22, 0x0B, 0x78, 0xB1});
+    a.JumpRelative(0x20, "maps");
+
+    if (cgb)
+    {
+        // attributes with palette, bank and flip bits
+        a.WriteIO(IO_ADDR_VBK, 1);
+        a.Word(0x21, 0x9800); a.Word(0x01, 0x0800);
+        a.Label("attrs");
+        a.Bytes({0x7D, 0xE6, 0x27, 0x22, 0x0B, 0x78, 0xB1});
+        a.JumpRelative(0x20, "attrs");
+        a.WriteIO(IO_ADDR_VBK, 0);
+
+        a.WriteIO(0x68, 0x80); a.Word(0x21, BENCH_ROM_DATA_ADDR + 0x100); a.Bytes({0x06, 64});
+        a.Label("bg_pal");
+        a.Bytes({0x2A, 0xE0, 0x69, 0x05});
+        a.JumpRelative(0x20, "bg_pal");
+
+        a.WriteIO(0x6A, 0x80); a.Word(0x21, BENCH_ROM_DATA_ADDR + 0x140); a.Bytes({0x06, 64});
+        a.Label("obj_pal");
+        a.Bytes({0x2A, 0xE0, 0x6B, 0x05});
+        a.JumpRelative(0x20, "obj_pal");
+
+        // general purpose hdma, 256 bytes into the second tile block
+        a.WriteIO(0x51, 0x10); a.WriteIO(0x52, 0x00); a.WriteIO(0x53, 0x01); a.WriteIO(0x54, 0x00);
+        a.WriteIO(0x55, 0x0F);
+    }
+
+    // 40 sprites spread over the screen
+    a.Word(0x21, 0xFE00); a.Bytes({0x06, 40});
+    a.Label("oam");
+    a.Bytes({0x78, 0x87, 0x87, 0xC6, 0x10, 0x22, 0x78, 0x87, 0x87, 0x22, 0x78, 0xE6, 0x0F, 0x22, 0x78, 0xE6, 0x70, 0x22, 0x05});
+    a.JumpRelative(0x20, "oam");
+
+    a.WriteIO(0x47, 0xE4); a.WriteIO(0x48, 0xE4); a.WriteIO(0x49, 0x1B);
+    a.WriteIO(0x4A, 80); a.WriteIO(0x4B, 87);
+
+    // all four sound channels
+    a.WriteIO(0x26, 0x80); a.WriteIO(0x24, 0x77); a.WriteIO(0x25, 0xF3);
+    a.WriteIO(0x11, 0x80); a.WriteIO(0x12, 0xF3); a.WriteIO(0x13, 0x40); a.WriteIO(0x14, 0x86);
+    a.WriteIO(0x16, 0x40); a.WriteIO(0x17, 0xA5); a.WriteIO(0x18, 0x90); a.WriteIO(0x19, 0x85);
+    a.Word(0x21, 0xFF30); a.Bytes({0x06, 16});
+    a.Label("wave");
+    a.Bytes({0x78, 0x87, 0x87, 0x87, 0x22, 0x05});
+    a.JumpRelative(0x20, "wave");
+    a.WriteIO(0x1A, 0x80); a.WriteIO(0x1C, 0x20); a.WriteIO(0x1D, 0x00); a.WriteIO(0x1E, 0x87);
+    a.WriteIO(0x21, 0xF1); a.WriteIO(0x22, 0x33); a.WriteIO(0x23, 0x80);
+
+    // lyc interrupt mid frame, lcd on with window and sprites
+    a.WriteIO(0x41, 0x40); a.WriteIO(0x45, 100);
+    a.WriteIO(0x40, 0xF3);
+    a.WriteIO(0xFF, 0x03);
+    a.Bytes({0xFB});
+
+    a.Label("main");
+    a.Bytes({0x76, 0x00});
+    a.Bytes({0xF0, 0x44, 0xFE, 144});
+    a.JumpRelative(0x38, "main");
+
+    // scroll, bump a frame counter and touch a tile every frame
+    a.Bytes({0xF0, 0x43, 0x3C, 0xE0, 0x43});
+    a.Bytes({0xFA, 0x00, 0xC0, 0x3C, 0xEA, 0x00, 0xC0});
+    a.Bytes({0xE6, 0x07, 0xE0, 0x42});
+    a.Word(0x21, 0x8010); a.Bytes({0x7E, 0x2F, 0x77});
+
+    // wait for the middle of the screen, then write vram and flip bgp
+    a.Label("mid_frame");
+    a.Bytes({0xF0, 0x44, 0xFE, 72});
+    a.JumpRelative(0x20, "mid_frame");
+    a.Word(0x21, 0x8020); a.Bytes({0x34});
+    a.Word(0x21, 0x9810); a.Bytes({0x34});
+    a.Bytes({0xF0, 0x47, 0x2F, 0xE0, 0x47});
+
+    // retrigger a note every 16 frames
+    a.Bytes({0xFA, 0x00, 0xC0, 0xE6, 0x0F});
+    a.JumpRelative(0x20, "no_note");
+    a.Bytes({0xFA, 0x00, 0xC0, 0xE0, 0x13});
+    a.WriteIO(0x14, 0x86);
+    a.Bytes({0x3E, 0x87, 0xE0, 0x1E});
+    a.Label("no_note");
+
+    if (cgb)
+    {
+        a.WriteIO(0x51, 0x10); a.WriteIO(0x52, 0x00); a.WriteIO(0x53, 0x02); a.WriteIO(0x54, 0x00);
+        a.WriteIO(0x55, 0x83);
+    }
+
+    a.Jump(0xC3, "main");
+
+    const std::vector<uint8_t>& code = a.Finish();
+    std::copy(code.begin(), code.end(), rom.begin() + 0x150);
+
+    // xorshift so the tile and palette data is the same on every platform
+    uint32_t seed = 0x2545F491;
+    for (int i = BENCH_ROM_DATA_ADDR; i < BENCH_ROM_DATA_ADDR + 0x180; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        rom[i] = static_cast<uint8_t>(seed >> 24);
+    }
+
+    return rom;
+}
+
+std::vector<uint8_t> BuildBootStub(bool cgb)
+{
+    std::vector<uint8_t> boot(cgb ? GB_CGB_BOOT_ROM_SIZE : GB_DMG_BOOT_ROM_SIZE, 0);
+
+    // jp 0x0100
+    boot[0] = 0xC3;
+    boot[1] = 0x00;
+    boot[2] = 0x01;
+
+    return boot;
+}
+
+bool WriteBenchFile(const std::string& path, const std::vector<uint8_t>& data)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    const size_t written = fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+
+    return written == data.size();
+}
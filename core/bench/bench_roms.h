@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define BENCH_ROM_SIZE 0x8000
+#define BENCH_ROM_DATA_ADDR 0x1000
+
+// a small rom exercising background, window, sprites, mid frame palette and
+// vram writes, sound and (in cgb mode) palettes and hdma, built from code so
+// results never depend on files that are not in the tree
+std::vector<uint8_t> BuildBenchRom(bool cgb);
+
+// stand in for the cgb boot rom, jumps straight to the cartridge entry point
+std::vector<uint8_t> BuildBootStub(bool cgb);
+
+bool WriteBenchFile(const std::string& path, const std::vector<uint8_t>& data);
@@ -0,0 +1,572 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "bench_roms.h"
+#include "../gameboy.h"
+
+#define BENCH_CPU_PROGRAM_BEGIN 0xC100
+#define BENCH_CPU_PROGRAM_END 0xCF00
+#define BENCH_CPU_SUBROUTINE 0xC000
+#define BENCH_CPU_SCRATCH 0xD800
+
+#define BENCH_ADDRESS_COUNT 4096
+#define BENCH_FRAME_WARMUP 30
+
+struct BenchFiles
+{
+    std::string dmg_rom;
+    std::string cgb_rom;
+    std::string cgb_boot;
+};
+
+// fixed seed xorshift, workloads must be identical between runs and platforms
+class BenchRandom
+{
+public:
+    uint32_t Next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    uint32_t Below(uint32_t limit) { return Next() % limit; }
+
+private:
+    uint32_t state = 0x9E3779B9;
+};
+
+// components wired together the same way GameBoy does, without the frame loop
+struct BenchSystem
+{
+    explicit BenchSystem(const std::string& rom_path)
+    {
+        cartridge.LoadRom(rom_path);
+
+        const bool cgb = cartridge.HasCGBSupport();
+        const size_t memory_offset = arena.Reserve(Memory::GetBufferSize(cgb));
+        const size_t ram_offset = arena.Reserve(cartridge.GetRamBufferSize());
+        arena.Allocate();
+
+        memory.AttachBuffer(arena.Get(memory_offset), cgb);
+        cartridge.AttachRam(arena.Get(ram_offset));
+        memory.AttachCartridge(&cartridge);
+        memory.AttachCPU(&cpu);
+        cpu.AttachMemory(&memory);
+    }
+
+    Arena arena;
+    Cartridge cartridge;
+    Memory memory;
+    CPU cpu;
+};
+
+enum class OpcodeMix
+{
+    MIX_ALU,
+    MIX_LOAD_STORE,
+    MIX_CONTROL,
+    MIX_PREFIXED,
+    MIX_MIXED
+};
+
+static bool is_register_operand(uint8_t index) { return (index & 7) != 6; }
+
+static void emit_alu(std::vector<uint8_t>& code, BenchRandom& random)
+{
+    static const uint8_t single_ops[] = {
+        0x04, 0x05, 0x0C, 0x0D, 0x14, 0x15, 0x1C, 0x1D, 0x24, 0x25, 0x2C, 0x2D, 0x3C, 0x3D,
+        0x03, 0x0B, 0x13, 0x1B, 0x23, 0x2B, 0x09, 0x19, 0x29,
+        0x07, 0x0F, 0x17, 0x1F, 0x27, 0x2F, 0x37, 0x3F,
+    };
+    static const uint8_t immediate_ops[] = {0xC6, 0xCE, 0xD6, 0xDE, 0xE6, 0xEE, 0xF6, 0xFE, 0x06, 0x0E, 0x3E};
+
+    switch (random.Below(4))
+    {
+    case 0:
+        code.push_back(single_ops[random.Below(sizeof(single_ops))]);
+        break;
+    case 1:
+        code.push_back(immediate_ops[random.Below(sizeof(immediate_ops))]);
+        code.push_back(static_cast<uint8_t>(random.Next()));
+        break;
+    case 2:
+    {
+        // ld r, r' without (hl)
+        uint8_t op;
+        do op = 0x40 + random.Below(0x40);
+        while (!is_register_operand(op) || !is_register_operand(op >> 3));
+        code.push_back(op);
+        break;
+    }
+    default:
+    {
+        // add/adc/sub/sbc/and/xor/or/cp a, r
+        uint8_t op;
+        do op = 0x80 + random.Below(0x40);
+        while (!is_register_operand(op));
+        code.push_back(op);
+        break;
+    }
+    }
+}
+
+static void emit_load_store(std::vector<uint8_t>& code, BenchRandom& random)
+{
+    static const uint8_t hl_ops[] = {0x22, 0x2A, 0x32, 0x3A, 0x77, 0x7E, 0x46, 0x4E, 0x70, 0x71, 0x34, 0x35, 0x86, 0xAE};
+
+    switch (random.Below(5))
+    {
+    case 0:
+        // ld hl, scratch keeps (hl) inside wram bank 1
+        code.insert(code.end(), {0x21, BENCH_CPU_SCRATCH & 0xFF, BENCH_CPU_SCRATCH >> 8});
+        break;
+    case 1:
+        // ldh (n), a / ldh a, (n) on hram
+        code.insert(code.end(), {static_cast<uint8_t>(random.Below(2) ? 0xE0 : 0xF0),
+                                 static_cast<uint8_t>(0x80 + random.Below(0x70))});
+        break;
+    case 2:
+    {
+        // ld (a16), a / ld a, (a16) on wram
+        const uint16_t address = BENCH_CPU_SCRATCH + random.Below(0x400);
+        code.insert(code.end(), {static_cast<uint8_t>(random.Below(2) ? 0xEA : 0xFA),
+                                 static_cast<uint8_t>(address & 0xFF), static_cast<uint8_t>(address >> 8)});
+        break;
+    }
+    default:
+        code.push_back(hl_ops[random.Below(sizeof(hl_ops))]);
+        break;
+    }
+}
+
+static void emit_control(std::vector<uint8_t>& code, BenchRandom& random)
+{
+    switch (random.Below(5))
+    {
+    case 0:
+        // jr / jr cc to the next instruction
+        code.insert(code.end(), {static_cast<uint8_t>(0x18 + random.Below(5) * 8), 0x00});
+        break;
+    case 1:
+        code.insert(code.end(), {0xCD, BENCH_CPU_SUBROUTINE & 0xFF, BENCH_CPU_SUBROUTINE >> 8});
+        break;
+    case 2:
+    {
+        const uint8_t pair = random.Below(4) * 0x10;
+        code.insert(code.end(), {static_cast<uint8_t>(0xC5 + pair), static_cast<uint8_t>(0xC1 + pair)});
+        break;
+    }
+    case 3:
+    {
+        // jp to the next instruction
+        const uint16_t next = BENCH_CPU_PROGRAM_BEGIN + code.size() + 3;
+        code.insert(code.end(), {0xC3, static_cast<uint8_t>(next & 0xFF), static_cast<uint8_t>(next >> 8)});
+        break;
+    }
+    default:
+        code.push_back(0x00);
+        break;
+    }
+}
+
+static void emit_prefixed(std::vector<uint8_t>& code, BenchRandom& random)
+{
+    uint8_t op;
+    do op = static_cast<uint8_t>(random.Next());
+    while (!is_register_operand(op));
+
+    code.insert(code.end(), {0xCB, op});
+}
+
+static std::vector<uint8_t> build_cpu_program(OpcodeMix mix)
+{
+    BenchRandom random;
+    std::vector<uint8_t> code = {0x21, BENCH_CPU_SCRATCH & 0xFF, BENCH_CPU_SCRATCH >> 8};
+
+    while (BENCH_CPU_PROGRAM_BEGIN + code.size() < BENCH_CPU_PROGRAM_END - 8)
+    {
+        OpcodeMix next = mix;
+        if (mix == OpcodeMix::MIX_MIXED)
+        {
+            // roughly what commercial games spend their time on
+            const uint32_t pick = random.Below(100);
+            next = pick < 40 ? OpcodeMix::MIX_ALU
+                 : pick < 75 ? OpcodeMix::MIX_LOAD_STORE
+                 : pick < 92 ? OpcodeMix::MIX_CONTROL
+                 : OpcodeMix::MIX_PREFIXED;
+        }
+
+        switch (next)
+        {
+        case OpcodeMix::MIX_ALU: emit_alu(code, random); break;
+        case OpcodeMix::MIX_LOAD_STORE: emit_load_store(code, random); break;
+        case OpcodeMix::MIX_CONTROL: emit_control(code, random); break;
+        default: emit_prefixed(code, random); break;
+        }
+    }
+
+    code.insert(code.end(), {0xC3, BENCH_CPU_PROGRAM_BEGIN & 0xFF, BENCH_CPU_PROGRAM_BEGIN >> 8});
+    return code;
+}
+
+static void bench_cpu(BenchRunner& runner, const BenchFiles& files)
+{
+    const struct
+    {
+        const char* name;
+        OpcodeMix mix;
+    } mixes[] = {
+        {"cpu/alu", OpcodeMix::MIX_ALU},
+        {"cpu/load_store", OpcodeMix::MIX_LOAD_STORE},
+        {"cpu/control", OpcodeMix::MIX_CONTROL},
+        {"cpu/prefixed", OpcodeMix::MIX_PREFIXED},
+        {"cpu/mixed", OpcodeMix::MIX_MIXED},
+    };
+
+    for (const auto& [name, mix] : mixes)
+    {
+        auto system = std::make_unique<BenchSystem>(files.dmg_rom);
+        Memory& memory = system->memory;
+        CPU& cpu = system->cpu;
+
+        const std::vector<uint8_t> program = build_cpu_program(mix);
+        for (size_t i = 0; i < program.size(); i++)
+            memory.Write8(BENCH_CPU_PROGRAM_BEGIN + i, program[i]);
+
+        memory.Write8(BENCH_CPU_SUBROUTINE, 0xC9);
+
+        cpu.reg.PC = BENCH_CPU_PROGRAM_BEGIN;
+        cpu.reg.SP = 0xFFFE;
+
+        runner.Run(name, "instruction", [&](uint64_t iterations)
+        {
+            int cycles = 0;
+            for (uint64_t i = 0; i < iterations; i++)
+                cycles += cpu.ExecuteInstruction();
+
+            DoNotOptimize(cycles);
+            return iterations;
+        });
+    }
+}
+
+static void fill_scanline_vram(uint8_t* vram0, uint8_t* vram1, bool cgb)
+{
+    BenchRandom random;
+    for (int i = 0; i < GB_VRAM_SIZE; i++)
+    {
+        vram0[i] = static_cast<uint8_t>(random.Next());
+        vram1[i] = cgb ? static_cast<uint8_t>(random.Next()) : 0;
+    }
+}
+
+static ScanlineState make_scanline_state(bool cgb)
+{
+    BenchRandom random;
+    ScanlineState state = {};
+
+    state.scanline = 100;
+    state.window_line = 20;
+    state.render_window = true;
+    state.lcdc = LCDC_ENABLE | LCDC_BG_ENABLE | LCDC_OBJ_ENABLE | LCDC_WINDOW_ENABLE | LCDC_TILE_DATA;
+    state.scy = 13;
+    state.scx = 5;
+    state.wx = 87;
+    state.bgp = 0xE4;
+    state.obp0 = 0xE4;
+    state.obp1 = 0x1B;
+    state.use_cgb_rendering = cgb;
+
+    state.object_count = OAM_MAX_SPRITES;
+    for (uint8_t i = 0; i < OAM_MAX_SPRITES; i++)
+    {
+        state.objects[i] = {
+            .y = static_cast<uint8_t>(state.scanline + 16 - (i & 7)),
+            .x = static_cast<uint8_t>(8 + i * 15),
+            .tile_index = static_cast<uint8_t>(random.Next()),
+            .attributes = static_cast<uint8_t>(random.Next()),
+            .oam_index = i
+        };
+    }
+
+    for (int palette = 0; palette < 8; palette++)
+    {
+        for (int color = 0; color < 4; color++)
+        {
+            state.bg_palette_cache[palette][color] = static_cast<uint16_t>(random.Next() & 0x7FFF);
+            state.obj_palette_cache[palette][color] = static_cast<uint16_t>(random.Next() & 0x7FFF);
+        }
+    }
+
+    return state;
+}
+
+static void bench_ppu(BenchRunner& runner, const BenchFiles& files)
+{
+    const GameBoySettings defaults;
+
+    for (const bool cgb : {false, true})
+    {
+        auto vram0 = std::make_unique<uint8_t[]>(GB_VRAM_SIZE);
+        auto vram1 = std::make_unique<uint8_t[]>(GB_VRAM_SIZE);
+        fill_scanline_vram(vram0.get(), vram1.get(), cgb);
+
+        auto renderer = std::make_unique<ScanlineRenderer>(defaults.palette);
+        const ScanlineState state = make_scanline_state(cgb);
+        uint16_t row[SCREEN_WIDTH] = {};
+
+        runner.Run(cgb ? "ppu/scanline_cgb" : "ppu/scanline_dmg", "line", [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                renderer->Render(state, vram0.get(), vram1.get(), row);
+                DoNotOptimize(row);
+            }
+            return iterations;
+        });
+    }
+
+    // the whole dot loop: oam scan, mode changes, stat and the rasterizer
+    for (const bool cgb : {false, true})
+    {
+        BenchSystem system(files.dmg_rom);
+        std::vector<uint16_t> framebuffer(SCREEN_WIDTH * SCREEN_HEIGHT);
+        auto ppu = std::make_unique<PPU>(framebuffer.data(), defaults.palette);
+        ppu->AttachMemory(&system.memory);
+        ppu->use_cgb_rendering = cgb;
+
+        BenchRandom random;
+        for (uint16_t address = ADDR_VRAM_BEGIN; address < ADDR_VRAM_END; address++)
+            system.memory.Write8(address, static_cast<uint8_t>(random.Next()));
+        for (uint16_t address = ADDR_OAM_BEGIN; address < ADDR_OAM_END; address++)
+            system.memory.Write8(address, static_cast<uint8_t>(random.Next()));
+
+        system.memory.Write8(ADDR_IO_BEGIN + IO_ADDR_BGP, 0xE4);
+        system.memory.Write8(ADDR_IO_BEGIN + IO_ADDR_WY, 80);
+        system.memory.Write8(ADDR_IO_BEGIN + IO_ADDR_WX, 87);
+        system.memory.Write8(ADDR_IO_BEGIN + IO_ADDR_LCDC, 0xF3);
+
+        runner.Run(cgb ? "ppu/frame_cgb" : "ppu/frame_dmg", "frame", [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                for (int dot = 0; dot < DOTS_TOTAL * (PPU_MAX_TOTAL_SCANLINE + 1); dot += T_CYCLES_PER_M_CYCLE)
+                    ppu->Cycle(T_CYCLES_PER_M_CYCLE);
+
+                ppu->ready_for_draw = false;
+            }
+            return iterations;
+        });
+    }
+}
+
+static void bench_apu(BenchRunner& runner, const BenchFiles& files)
+{
+    BenchSystem system(files.dmg_rom);
+    APU apu;
+    apu.AttachMemory(&system.memory);
+
+    // all channels running, panned to both sides
+    const uint8_t setup[][2] = {
+        {0x26, 0x80}, {0x24, 0x77}, {0x25, 0xFF},
+        {0x10, 0x15}, {0x11, 0x80}, {0x12, 0xF3}, {0x13, 0x40}, {0x14, 0x87},
+        {0x16, 0x40}, {0x17, 0xA5}, {0x18, 0x90}, {0x19, 0x85},
+        {0x1A, 0x80}, {0x1C, 0x20}, {0x1D, 0x00}, {0x1E, 0x87},
+        {0x21, 0xF1}, {0x22, 0x33}, {0x23, 0x80},
+    };
+
+    for (uint8_t i = 0; i < 16; i++)
+        system.memory.Write8(0xFF30 + i, static_cast<uint8_t>(i * 0x11));
+
+    for (const auto& [reg, value] : setup)
+        system.memory.Write8(ADDR_IO_BEGIN + reg, value);
+
+    runner.Run("apu/cycle", "mcycle", [&](uint64_t iterations)
+    {
+        float left = 0.0f, right = 0.0f;
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            apu.Cycle(T_CYCLES_PER_M_CYCLE);
+            if (apu.ready_for_samples)
+            {
+                const AudioSample* block_left;
+                const AudioSample* block_right;
+                const size_t count = apu.TakeSamples(block_left, block_right);
+                left += AudioSampleToFloat(block_left[count - 1]);
+                right += AudioSampleToFloat(block_right[count - 1]);
+            }
+        }
+
+        DoNotOptimize(left + right);
+        return iterations;
+    });
+}
+
+static void bench_memory(BenchRunner& runner, const BenchFiles& files)
+{
+    BenchSystem system(files.dmg_rom);
+    Memory& memory = system.memory;
+
+    const struct
+    {
+        const char* name;
+        uint16_t begin;
+        uint16_t end;
+        bool writable;
+    } regions[] = {
+        {"rom0", 0x0000, 0x4000, false},
+        {"romx", 0x4000, 0x8000, false},
+        {"vram", ADDR_VRAM_BEGIN, ADDR_VRAM_END, true},
+        {"wram0", ADDR_WRAM0_BEGIN, ADDR_WRAM0_END, true},
+        {"wramx", ADDR_WRAM_BANK_BEGIN, ADDR_WRAM_BANK_END, true},
+        {"echo", ADDR_ECHO_BEGIN, ADDR_ECHO_END, true},
+        {"oam", ADDR_OAM_BEGIN, ADDR_OAM_END, true},
+        {"io", 0xFF80 - 0x30, 0xFF80, true},
+        {"hram", ADDR_HRAM_BEGIN, ADDR_HRAM_END, true},
+    };
+
+    for (const auto& region : regions)
+    {
+        BenchRandom random;
+        std::vector<uint16_t> addresses(BENCH_ADDRESS_COUNT);
+        for (uint16_t& address : addresses)
+            address = static_cast<uint16_t>(region.begin + random.Below(region.end - region.begin));
+
+        runner.Run(std::string("memory/read8_") + region.name, "access", [&](uint64_t iterations)
+        {
+            uint32_t sum = 0;
+            for (uint64_t i = 0; i < iterations; i++)
+                sum += memory.Read8(addresses[i & (BENCH_ADDRESS_COUNT - 1)]);
+
+            DoNotOptimize(sum);
+            return iterations;
+        });
+
+        if (!region.writable)
+            continue;
+
+        runner.Run(std::string("memory/write8_") + region.name, "access", [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+                memory.Write8(addresses[i & (BENCH_ADDRESS_COUNT - 1)], static_cast<uint8_t>(i));
+            return iterations;
+        });
+    }
+}
+
+static void bench_system(BenchRunner& runner, const BenchFiles& files)
+{
+    struct SystemCase
+    {
+        bool threaded;
+        bool muted;
+    };
+
+    for (const auto [threaded, muted] : {SystemCase{false, false}, SystemCase{true, false}, SystemCase{false, true}})
+    {
+        for (const bool cgb : {false, true})
+        {
+            GameBoy game_boy(cgb ? files.cgb_rom : files.dmg_rom, {.threaded_rendering = threaded});
+            if (cgb)
+                game_boy.LoadBootRom(files.cgb_boot);
+
+            uint64_t draws = 0;
+            game_boy.OnDraw([&](uint16_t*) { draws++; });
+            game_boy.OnAudio([](AudioSample, AudioSample) {});
+            game_boy.SetAudioMuted(muted);
+
+            for (int i = 0; i < BENCH_FRAME_WARMUP; i++)
+                game_boy.TickFrame();
+
+            std::string name = cgb ? "system/frame_cgb" : "system/frame_dmg";
+            if (threaded)
+                name += "_threaded";
+            if (muted)
+                name += "_muted";
+
+            runner.Run(name, "frame", [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                    game_boy.TickFrame();
+                return iterations;
+            });
+        }
+    }
+}
+
+static void print_usage()
+{
+    fprintf(stderr,
+            "usage: pesto_gb_bench [--filter <substring>] [--min-time <ms>] [--json <path>]\n"
+            "  results are written as json to stdout unless --json is given\n");
+}
+
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::string json_path;
+    uint32_t min_time_ms = BENCH_DEFAULT_MIN_TIME_MS;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            filter = argv[++i];
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+            min_time_ms = static_cast<uint32_t>(atoi(argv[++i]));
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json_path = argv[++i];
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    const std::filesystem::path temp = std::filesystem::temp_directory_path();
+    BenchFiles files = {
+        .dmg_rom = (temp / "pesto_gb_bench_dmg.gb").string(),
+        .cgb_rom = (temp / "pesto_gb_bench_cgb.gbc").string(),
+        .cgb_boot = (temp / "pesto_gb_bench_cgb_boot.bin").string(),
+    };
+
+    if (!WriteBenchFile(files.dmg_rom, BuildBenchRom(false)) ||
+        !WriteBenchFile(files.cgb_rom, BuildBenchRom(true)) ||
+        !WriteBenchFile(files.cgb_boot, BuildBootStub(true)))
+    {
+        fprintf(stderr, "Failed to write benchmark roms to %s\n", temp.string().c_str());
+        return 1;
+    }
+
+    BenchRunner runner(filter, min_time_ms);
+    bench_cpu(runner, files);
+    bench_ppu(runner, files);
+    bench_apu(runner, files);
+    bench_memory(runner, files);
+    bench_system(runner, files);
+
+    FILE* out = stdout;
+    if (!json_path.empty())
+    {
+        out = fopen(json_path.c_str(), "w");
+        if (out == nullptr)
+        {
+            fprintf(stderr, "Failed to open %s\n", json_path.c_str());
+            return 1;
+        }
+    }
+
+    runner.WriteJSON(out);
+
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
@@ -3,21 +3,19 @@
 #include "instruction/instruction_def.h"
 #include "instruction/instruction_set.h"
 
-CPU::CPU()
-{
-    InstructionSet::Initialize();
-}
-
 void CPU::AttachMemory(Memory* mem)
 {
     this->memory = mem;
 
     IF = memory->PtrIO(IO_ADDR_INTERRUPT_FLAG);
     IE = &memory->ie;
+    KEY1 = memory->PtrIO(IO_ADDR_KEY1);
 }
 
 int CPU::ExecuteInstruction()
 {
+    PROFILE_COUNT(memory->stats, COUNTER_INSTRUCTIONS);
+
     uint16_t addr = this->reg.PC;
     uint8_t op = this->memory->Read8(addr++);
 
@@ -49,9 +47,19 @@ int CPU::ExecuteInstruction()
         }
     }
 
+#ifdef PESTO_GB_PROFILE
+    const uint16_t start_pc = this->reg.PC;
+#endif
+
     this->reg.PC = addr;
     this->exec_cycles = def->main_cycles;
     def->func(this, def);
+
+#ifdef PESTO_GB_PROFILE
+    if (this->execution_profile) [[unlikely]]
+        this->execution_profile->Record(start_pc, this->memory->cartridge->GetRomBank(), op, is_prefix, this->exec_cycles);
+#endif
+
     return this->exec_cycles;
 }
 
@@ -77,17 +85,21 @@ int CPU::Cycle()
     }
 
 
-    if (this->halt && interrupt_pending)
+    // a speed switch is a halt that interrupts can't end
+    if (this->halt && interrupt_pending && this->speed_switch_mcycles == 0)
         this->halt = false;
 
     int cycles_elapsed;
-    if (this->ime && TryExecuteInterrupts(interrupt_pending))
+    if (this->ime && !this->halt && TryExecuteInterrupts(interrupt_pending))
     {
         cycles_elapsed = INTERRUPT_MCYCLES;
     }
     else if (this->halt)
     {
         cycles_elapsed = 1;
+
+        if (this->speed_switch_mcycles > 0 && --this->speed_switch_mcycles == 0)
+            this->halt = false;
     }
     else
     {
@@ -135,6 +147,21 @@ bool CPU::TryExecuteInterrupts(uint8_t interrupt_pending)
     return false;
 }
 
+void CPU::Stop()
+{
+    if (!this->memory->IsCGB() || !(*KEY1 & KEY1_PREPARE_SWITCH))
+    {
+        this->stop = true;
+        return;
+    }
+
+    this->double_speed = !this->double_speed;
+    *KEY1 = KEY1_UNUSED_BITS | (this->double_speed ? KEY1_CURRENT_SPEED : 0);
+
+    this->halt = true;
+    this->speed_switch_mcycles = SPEED_SWITCH_MCYCLES;
+}
+
 void CPU::Push16(uint16_t value)
 {
     this->reg.SP -= sizeof(uint16_t);
@@ -153,3 +180,47 @@ void CPU::ExecuteInterrupt(uint16_t addr)
     Push16(this->reg.PC);
     this->reg.PC = addr;
 }
+
+void CPU::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->reg.AF);
+    writer.Write(this->reg.BC);
+    writer.Write(this->reg.DE);
+    writer.Write(this->reg.HL);
+    writer.Write(this->reg.PC);
+    writer.Write(this->reg.SP);
+
+    writer.Write(this->cycles);
+    writer.Write(this->imm.u16);
+    writer.Write(this->exec_cycles);
+
+    writer.Write(this->stop);
+    writer.Write(this->halt);
+    writer.Write(this->ime);
+    writer.Write(this->ime_pending);
+
+    writer.Write(this->double_speed);
+    writer.Write(this->speed_switch_mcycles);
+}
+
+void CPU::LoadState(StateReader& reader)
+{
+    reader.Read(this->reg.AF);
+    reader.Read(this->reg.BC);
+    reader.Read(this->reg.DE);
+    reader.Read(this->reg.HL);
+    reader.Read(this->reg.PC);
+    reader.Read(this->reg.SP);
+
+    reader.Read(this->cycles);
+    reader.Read(this->imm.u16);
+    reader.Read(this->exec_cycles);
+
+    reader.Read(this->stop);
+    reader.Read(this->halt);
+    reader.Read(this->ime);
+    reader.Read(this->ime_pending);
+
+    reader.Read(this->double_speed);
+    reader.Read(this->speed_switch_mcycles);
+}
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include "registers.h"
 #include "../memory/memory.h"
+#include "../profiling/execution_profile.h"
 
 #define CLOCK_RATE 4194304
 #define CLOCK_CYCLE (1000000000 / CLOCK_RATE)
@@ -28,20 +29,25 @@
 
 #define INTERRUPT_MCYCLES 5
 
+// the cpu sits still for this long after a stop that switches speed
+#define SPEED_SWITCH_MCYCLES 2050
+
 class CPU
 {
 public:
-    CPU();
-
     void AttachMemory(Memory* mem);
 
     int Cycle();
     int ExecuteInstruction();
     bool TryExecuteInterrupts(uint8_t interrupt_pending);
+    void Stop();
 
     void Push16(uint16_t value);
     uint16_t Pop16();
 
+    void SaveState(StateWriter& writer) const;
+    void LoadState(StateReader& reader);
+
     Registers reg = {};
     uint64_t cycles = 0;
 
@@ -55,14 +61,22 @@ public:
 
     bool stop = false;
     bool halt = false;
+
+    // cgb double speed, the cpu, timer and serial port run at twice the rate of the ppu and apu
+    bool double_speed = false;
+    uint16_t speed_switch_mcycles = 0;
     bool ime = false;
     bool ime_pending = false;
 
     Memory* memory = nullptr;
 
+    // only recorded into when the core is built with PESTO_GB_PROFILE
+    std::unique_ptr<ExecutionProfile> execution_profile = nullptr;
+
 private:
     void ExecuteInterrupt(uint16_t addr);
 
     uint8_t* IF = nullptr;
     uint8_t* IE = nullptr;
+    uint8_t* KEY1 = nullptr;
 };
@@ -1,5 +1,6 @@
 #include "instruction_set.h"
 
+#include <array>
 #include <future>
 
 // Special
@@ -14,7 +15,7 @@ void halt(CPU* cpu, const InstructionDef* def)
 
 void stop(CPU* cpu, const InstructionDef* def)
 {
-    cpu->stop = true;
+    cpu->Stop();
 }
 
 void di(CPU* cpu, const InstructionDef* def)
@@ -1264,616 +1265,615 @@ void set_bit_m16(CPU* cpu, const InstructionDef* def)
     cpu->memory->Write8(*reg, value);
 }
 
-InstructionDef* InstructionSet::instructions[INSTRUCTION_SET_SIZE] = {
-
-    new InstructionDef("NOP", 0x00, nop, 1, 1, 1),
-    new InstructionDef("LD BC, d16", 0x01, ld_r16_d16, 3, 3, 3, RegisterType::REG_BC),
-    new InstructionDef("LD (BC), A", 0x02, ld_m16_r8, 1, 2, 2, RegisterType::REG_BC, RegisterType::REG_A),
-    new InstructionDef("INC BC", 0x03, inc_r16, 1, 2, 2, RegisterType::REG_BC),
-    new InstructionDef("INC B", 0x04, inc_r8, 1, 1, 1, RegisterType::REG_B),
-    new InstructionDef("DEC B", 0x05, dec_r8, 1, 1, 1, RegisterType::REG_B),
-    new InstructionDef("LD B, d8", 0x06, ld_r8_d8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("RLCA", 0x07, rlca, 1, 1, 1),
-    new InstructionDef("LD (a16), SP", 0x08, ld_imm16_r16, 3, 5, 5, RegisterType::REG_SP),
-    new InstructionDef("ADD HL, BC", 0x09, add_r16_r16, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_BC),
-    new InstructionDef("LD A, (BC)", 0x0A, ld_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_BC),
-    new InstructionDef("DEC BC", 0x0B, dec_r16, 1, 2, 2, RegisterType::REG_BC),
-    new InstructionDef("INC C", 0x0C, inc_r8, 1, 1, 1, RegisterType::REG_C),
-    new InstructionDef("DEC C", 0x0D, dec_r8, 1, 1, 1, RegisterType::REG_C),
-    new InstructionDef("LD C, d8", 0x0E, ld_r8_d8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("RRCA", 0x0F, rrca, 1, 1, 1),
-
-    new InstructionDef("STOP", 0x10, stop, 2, 1, 1, RegisterType::REG_DE),
-    new InstructionDef("LD DE, d16", 0x11, ld_r16_d16, 3, 3, 3, RegisterType::REG_DE),
-    new InstructionDef("LD (DE), A", 0x12, ld_m16_r8, 1, 2, 2, RegisterType::REG_DE, RegisterType::REG_A),
-    new InstructionDef("INC DE", 0x13, inc_r16, 1, 2, 2, RegisterType::REG_DE),
-    new InstructionDef("INC D", 0x14, inc_r8, 1, 1, 1, RegisterType::REG_D),
-    new InstructionDef("DEC D", 0x15, dec_r8, 1, 1, 1, RegisterType::REG_D),
-    new InstructionDef("LD D, d8", 0x16, ld_r8_d8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("RLA", 0x17, rla, 1, 1, 1),
-    new InstructionDef("JR s8", 0x18, jr_s8, 2, 3, 3),
-    new InstructionDef("ADD HL, DE", 0x19, add_r16_r16, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_DE),
-    new InstructionDef("LD A, (DE)", 0x1A, ld_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_DE),
-    new InstructionDef("DEC DE", 0x1B, dec_r16, 1, 2, 2, RegisterType::REG_DE),
-    new InstructionDef("INC E", 0x1C, inc_r8, 1, 1, 1, RegisterType::REG_E),
-    new InstructionDef("DEC E", 0x1D, dec_r8, 1, 1, 1, RegisterType::REG_E),
-    new InstructionDef("LD E, d8", 0x1E, ld_r8_d8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("RRA", 0x1F, rra, 1, 1, 1),
-
-    new InstructionDef("JR NZ, s8", 0x20, jr_nz_s8, 2, 2, 3),
-    new InstructionDef("LD HL, d16", 0x21, ld_r16_d16, 3, 3, 3, RegisterType::REG_HL),
-    new InstructionDef("LD (HL+), A", 0x22, ldi_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_A),
-    new InstructionDef("INC HL", 0x23, inc_r16, 1, 2, 2, RegisterType::REG_HL),
-    new InstructionDef("INC H", 0x24, inc_r8, 1, 1, 1, RegisterType::REG_H),
-    new InstructionDef("DEC H", 0x25, dec_r8, 1, 1, 1, RegisterType::REG_H),
-    new InstructionDef("LD H, d8", 0x26, ld_r8_d8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("DAA", 0x27, daa, 1, 1, 1),
-    new InstructionDef("JR Z, s8", 0x28, jr_z_s8, 2, 2, 3),
-    new InstructionDef("ADD HL, HL", 0x29, add_r16_r16, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_HL),
-    new InstructionDef("LD A, (HL+)", 0x2A, ldi_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("DEC HL", 0x2B, dec_r16, 1, 2, 2, RegisterType::REG_HL),
-    new InstructionDef("INC L", 0x2C, inc_r8, 1, 1, 1, RegisterType::REG_L),
-    new InstructionDef("DEC L", 0x2D, dec_r8, 1, 1, 1, RegisterType::REG_L),
-    new InstructionDef("LD L, d8", 0x2E, ld_r8_d8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("CPL", 0x2F, cpl, 1, 1, 1),
-
-    new InstructionDef("JR NC, s8", 0x30, jr_nc_s8, 2, 2, 3),
-    new InstructionDef("LD SP, d16", 0x31, ld_r16_d16, 3, 3, 3, RegisterType::REG_SP),
-    new InstructionDef("LD (HL-), A", 0x32, ldd_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_A),
-    new InstructionDef("INC SP", 0x33, inc_r16, 1, 2, 2, RegisterType::REG_SP),
-    new InstructionDef("INC (HL)", 0x34, inc_m16, 1, 3, 3, RegisterType::REG_HL),
-    new InstructionDef("DEC (HL)", 0x35, dec_m16, 1, 3, 3, RegisterType::REG_HL),
-    new InstructionDef("LD (HL), d8", 0x36, ld_m16_d8, 2, 3, 3, RegisterType::REG_HL),
-    new InstructionDef("SCF", 0x37, scf, 1, 1, 1),
-    new InstructionDef("JR C, s8", 0x38, jr_c_s8, 2, 2, 3),
-    new InstructionDef("ADD HL, SP", 0x39, add_r16_r16, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_SP),
-    new InstructionDef("LD A, (HL-)", 0x3A, ldd_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("DEC SP", 0x3B, dec_r16, 1, 2, 2, RegisterType::REG_SP),
-    new InstructionDef("INC A", 0x3C, inc_r8, 1, 1, 1, RegisterType::REG_A),
-    new InstructionDef("DEC A", 0x3D, dec_r8, 1, 1, 1, RegisterType::REG_A),
-    new InstructionDef("LD A, d8", 0x3E, ld_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("CCF", 0x3F, ccf, 1, 1, 1),
-
-    new InstructionDef("LD B, B", 0x40, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_B),
-    new InstructionDef("LD B, C", 0x41, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_C),
-    new InstructionDef("LD B, D", 0x42, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_D),
-    new InstructionDef("LD B, E", 0x43, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_E),
-    new InstructionDef("LD B, H", 0x44, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_H),
-    new InstructionDef("LD B, L", 0x45, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_L),
-    new InstructionDef("LD B, (HL)", 0x46, ld_r8_m16, 1, 2, 2, RegisterType::REG_B, RegisterType::REG_HL),
-    new InstructionDef("LD B, A", 0x47, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_A),
-
-    new InstructionDef("LD C, B", 0x48, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_B),
-    new InstructionDef("LD C, C", 0x49, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_C),
-    new InstructionDef("LD C, D", 0x4A, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_D),
-    new InstructionDef("LD C, E", 0x4B, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_E),
-    new InstructionDef("LD C, H", 0x4C, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_H),
-    new InstructionDef("LD C, L", 0x4D, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_L),
-    new InstructionDef("LD C, (HL)", 0x4E, ld_r8_m16, 1, 2, 2, RegisterType::REG_C, RegisterType::REG_HL),
-    new InstructionDef("LD C, A", 0x4F, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_A),
-
-    new InstructionDef("LD D, B", 0x50, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_B),
-    new InstructionDef("LD D, C", 0x51, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_C),
-    new InstructionDef("LD D, D", 0x52, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_D),
-    new InstructionDef("LD D, E", 0x53, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_E),
-    new InstructionDef("LD D, H", 0x54, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_H),
-    new InstructionDef("LD D, L", 0x55, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_L),
-    new InstructionDef("LD D, (HL)", 0x56, ld_r8_m16, 1, 2, 2, RegisterType::REG_D, RegisterType::REG_HL),
-    new InstructionDef("LD D, A", 0x57, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_A),
-
-    new InstructionDef("LD E, B", 0x58, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_B),
-    new InstructionDef("LD E, C", 0x59, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_C),
-    new InstructionDef("LD E, D", 0x5A, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_D),
-    new InstructionDef("LD E, E", 0x5B, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_E),
-    new InstructionDef("LD E, H", 0x5C, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_H),
-    new InstructionDef("LD E, L", 0x5D, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_L),
-    new InstructionDef("LD E, (HL)", 0x5E, ld_r8_m16, 1, 2, 2, RegisterType::REG_E, RegisterType::REG_HL),
-    new InstructionDef("LD E, A", 0x5F, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_A),
-
-    new InstructionDef("LD H, B", 0x60, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_B),
-    new InstructionDef("LD H, C", 0x61, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_C),
-    new InstructionDef("LD H, D", 0x62, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_D),
-    new InstructionDef("LD H, E", 0x63, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_E),
-    new InstructionDef("LD H, H", 0x64, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_H),
-    new InstructionDef("LD H, L", 0x65, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_L),
-    new InstructionDef("LD H, (HL)", 0x66, ld_r8_m16, 1, 2, 2, RegisterType::REG_H, RegisterType::REG_HL),
-    new InstructionDef("LD H, A", 0x67, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_A),
-
-    new InstructionDef("LD L, B", 0x68, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_B),
-    new InstructionDef("LD L, C", 0x69, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_C),
-    new InstructionDef("LD L, D", 0x6A, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_D),
-    new InstructionDef("LD L, E", 0x6B, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_E),
-    new InstructionDef("LD L, H", 0x6C, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_H),
-    new InstructionDef("LD L, L", 0x6D, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_L),
-    new InstructionDef("LD L, (HL)", 0x6E, ld_r8_m16, 1, 2, 2, RegisterType::REG_L, RegisterType::REG_HL),
-    new InstructionDef("LD L, A", 0x6F, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_A),
-
-    new InstructionDef("LD (HL), B", 0x70, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_B),
-    new InstructionDef("LD (HL), C", 0x71, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_C),
-    new InstructionDef("LD (HL), D", 0x72, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_D),
-    new InstructionDef("LD (HL), E", 0x73, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_E),
-    new InstructionDef("LD (HL), H", 0x74, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_H),
-    new InstructionDef("LD (HL), L", 0x75, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_L),
-    new InstructionDef("HALT", 0x76, halt, 1, 1, 1),
-    new InstructionDef("LD (HL), A", 0x77, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_A),
-
-    new InstructionDef("LD A, B", 0x78, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("LD A, C", 0x79, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("LD A, D", 0x7A, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("LD A, E", 0x7B, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("LD A, H", 0x7C, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("LD A, L", 0x7D, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("LD A, (HL)", 0x7E, ld_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("LD A, A", 0x7F, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("ADD A, B", 0x80, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("ADD A, C", 0x81, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("ADD A, D", 0x82, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("ADD A, E", 0x83, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("ADD A, H", 0x84, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("ADD A, L", 0x85, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("ADD A, (HL)", 0x86, add_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("ADD A, A", 0x87, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("ADC A, B", 0x88, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("ADC A, C", 0x89, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("ADC A, D", 0x8A, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("ADC A, E", 0x8B, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("ADC A, H", 0x8C, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("ADC A, L", 0x8D, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("ADC A, (HL)", 0x8E, adc_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("ADC A, A", 0x8F, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("SUB A, B", 0x90, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("SUB A, C", 0x91, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("SUB A, D", 0x92, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("SUB A, E", 0x93, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("SUB A, H", 0x94, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("SUB A, L", 0x95, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("SUB A, (HL)", 0x96, sub_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("SUB A, A", 0x97, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("SBC A, B", 0x98, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("SBC A, C", 0x99, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("SBC A, D", 0x9A, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("SBC A, E", 0x9B, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("SBC A, H", 0x9C, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("SBC A, L", 0x9D, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("SBC A, (HL)", 0x9E, sbc_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("SBC A, A", 0x9F, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("AND A, B", 0xA0, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("AND A, C", 0xA1, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("AND A, D", 0xA2, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("AND A, E", 0xA3, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("AND A, H", 0xA4, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("AND A, L", 0xA5, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("AND A, (HL)", 0xA6, and_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("AND A, A", 0xA7, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("XOR A, B", 0xA8, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("XOR A, C", 0xA9, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("XOR A, D", 0xAA, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("XOR A, E", 0xAB, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("XOR A, H", 0xAC, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("XOR A, L", 0xAD, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("XOR A, (HL)", 0xAE, xor_r8_r16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("XOR A, A", 0xAF, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("OR A, B", 0xB0, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("OR A, C", 0xB1, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("OR A, D", 0xB2, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("OR A, E", 0xB3, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("OR A, H", 0xB4, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("OR A, L", 0xB5, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("OR A, (HL)", 0xB6, or_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("OR A, A", 0xB7, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("CP A, B", 0xB8, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B),
-    new InstructionDef("CP A, C", 0xB9, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("CP A, D", 0xBA, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D),
-    new InstructionDef("CP A, E", 0xBB, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E),
-    new InstructionDef("CP A, H", 0xBC, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H),
-    new InstructionDef("CP A, L", 0xBD, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L),
-    new InstructionDef("CP A, (HL)", 0xBE, cp_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL),
-    new InstructionDef("CP A, A", 0xBF, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A),
-
-    new InstructionDef("RET NZ", 0xC0, ret_nz, 1, 2, 5),
-    new InstructionDef("POP BC", 0xC1, pop_r16, 1, 3, 3, RegisterType::REG_BC),
-    new InstructionDef("JP NZ, a16", 0xC2, jp_nz_a16, 3, 3, 4),
-    new InstructionDef("JP a16", 0xC3, jp_a16, 3, 4, 4),
-    new InstructionDef("CALL NZ, a16", 0xC4, call_nz_a16, 3, 3, 6),
-    new InstructionDef("PUSH BC", 0xC5, push_r16, 1, 4, 4, RegisterType::REG_BC),
-    new InstructionDef("ADD A, d8", 0xC6, add_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("RST 0", 0xC7, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x00),
-    new InstructionDef("RET Z", 0xC8, ret_z, 1, 2, 5),
-    new InstructionDef("RET", 0xC9, ret, 1, 4, 4),
-    new InstructionDef("JP Z, a16", 0xCA, jp_z_a16, 3, 3, 4),
-    new InstructionDef("CALL Z, a16", 0xCC, call_z_a16, 3, 3, 6),
-    new InstructionDef("CALL a16", 0xCD, call_a16, 3, 6, 6),
-    new InstructionDef("ADC A, d8", 0xCE, adc_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("RST 1", 0xCF, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x08),
-
-    new InstructionDef("RET NC", 0xD0, ret_nc, 1, 2, 5),
-    new InstructionDef("POP DE", 0xD1, pop_r16, 1, 3, 3, RegisterType::REG_DE),
-    new InstructionDef("JP NC, a16", 0xD2, jp_nc_a16, 3, 3, 4),
-    new InstructionDef("CALL NC, a16", 0xD4, call_nc_a16, 3, 3, 6),
-    new InstructionDef("PUSH DE", 0xD5, push_r16, 1, 4, 4, RegisterType::REG_DE),
-    new InstructionDef("SUB A, d8", 0xD6, sub_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("RST 2", 0xD7, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x10),
-    new InstructionDef("RET C", 0xD8, ret_c, 1, 2, 5),
-    new InstructionDef("RETI", 0xD9, reti, 1, 4, 4),
-    new InstructionDef("JP C, a16", 0xDA, jp_c_a16, 3, 3, 4),
-    new InstructionDef("CALL C, a16", 0xDC, call_c_a16, 3, 3, 6),
-    new InstructionDef("SBC A, d8", 0xDE, sbc_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("RST 3", 0xDF, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x18),
-
-    new InstructionDef("LD (a8), A", 0xE0, ld_imm8_r8, 2, 3, 3, RegisterType::REG_A),
-    new InstructionDef("POP HL", 0xE1, pop_r16, 1, 3, 3, RegisterType::REG_HL),
-    new InstructionDef("LD (C), A", 0xE2, ld_m8_r8, 1, 2, 2, RegisterType::REG_C, RegisterType::REG_A),
-    new InstructionDef("PUSH HL", 0xE5, push_r16, 1, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("AND A, d8", 0xE6, and_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("RST 4", 0xE7, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x20),
-    new InstructionDef("ADD SP, s8", 0xE8, add_r16_s8, 2, 4, 4, RegisterType::REG_SP),
-    new InstructionDef("JP HL", 0xE9, jp_r16, 1, 1, 1, RegisterType::REG_HL),
-    new InstructionDef("LD (a16), A", 0xEA, ld_imm16_r8, 3, 4, 4, RegisterType::REG_A),
-    new InstructionDef("XOR A, d8", 0xEE, xor_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("RST 5", 0xEF, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x28),
-
-    new InstructionDef("LD A, (a8)", 0xF0, ld_r8_imm8, 2, 3, 3, RegisterType::REG_A),
-    new InstructionDef("POP AF", 0xF1, pop_r16, 1, 3, 3, RegisterType::REG_AF),
-    new InstructionDef("LD A, (C)", 0xF2, ld_r8_m8, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_C),
-    new InstructionDef("DI", 0xF3, di, 1, 1, 1),
-    new InstructionDef("PUSH AF", 0xF5, push_r16, 1, 4, 4, RegisterType::REG_AF),
-    new InstructionDef("OR A, d8", 0xF6, or_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("RST 6", 0xF7, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x30),
-    new InstructionDef("LD HL, SP+s8", 0xF8, ld_r16_r16_s8, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_SP),
-    new InstructionDef("LD SP, HL", 0xF9, ld_r16_r16, 1, 2, 2, RegisterType::REG_SP, RegisterType::REG_HL),
-    new InstructionDef("LD A, (a16)", 0xFA, ld_r8_imm16, 3, 4, 4, RegisterType::REG_A),
-    new InstructionDef("EI", 0xFB, ei, 1, 1, 1),
-    new InstructionDef("CP A, d8", 0xFE, cp_r8_d8, 2, 2, 2, RegisterType::REG_A),
-    new InstructionDef("RST 7", 0xFF, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x38),
+static constexpr InstructionDef instructions[] = {
+
+    {"NOP", 0x00, nop, 1, 1, 1},
+    {"LD BC, d16", 0x01, ld_r16_d16, 3, 3, 3, RegisterType::REG_BC},
+    {"LD (BC), A", 0x02, ld_m16_r8, 1, 2, 2, RegisterType::REG_BC, RegisterType::REG_A},
+    {"INC BC", 0x03, inc_r16, 1, 2, 2, RegisterType::REG_BC},
+    {"INC B", 0x04, inc_r8, 1, 1, 1, RegisterType::REG_B},
+    {"DEC B", 0x05, dec_r8, 1, 1, 1, RegisterType::REG_B},
+    {"LD B, d8", 0x06, ld_r8_d8, 2, 2, 2, RegisterType::REG_B},
+    {"RLCA", 0x07, rlca, 1, 1, 1},
+    {"LD (a16), SP", 0x08, ld_imm16_r16, 3, 5, 5, RegisterType::REG_SP},
+    {"ADD HL, BC", 0x09, add_r16_r16, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_BC},
+    {"LD A, (BC)", 0x0A, ld_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_BC},
+    {"DEC BC", 0x0B, dec_r16, 1, 2, 2, RegisterType::REG_BC},
+    {"INC C", 0x0C, inc_r8, 1, 1, 1, RegisterType::REG_C},
+    {"DEC C", 0x0D, dec_r8, 1, 1, 1, RegisterType::REG_C},
+    {"LD C, d8", 0x0E, ld_r8_d8, 2, 2, 2, RegisterType::REG_C},
+    {"RRCA", 0x0F, rrca, 1, 1, 1},
+
+    {"STOP", 0x10, stop, 2, 1, 1, RegisterType::REG_DE},
+    {"LD DE, d16", 0x11, ld_r16_d16, 3, 3, 3, RegisterType::REG_DE},
+    {"LD (DE), A", 0x12, ld_m16_r8, 1, 2, 2, RegisterType::REG_DE, RegisterType::REG_A},
+    {"INC DE", 0x13, inc_r16, 1, 2, 2, RegisterType::REG_DE},
+    {"INC D", 0x14, inc_r8, 1, 1, 1, RegisterType::REG_D},
+    {"DEC D", 0x15, dec_r8, 1, 1, 1, RegisterType::REG_D},
+    {"LD D, d8", 0x16, ld_r8_d8, 2, 2, 2, RegisterType::REG_D},
+    {"RLA", 0x17, rla, 1, 1, 1},
+    {"JR s8", 0x18, jr_s8, 2, 3, 3},
+    {"ADD HL, DE", 0x19, add_r16_r16, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_DE},
+    {"LD A, (DE)", 0x1A, ld_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_DE},
+    {"DEC DE", 0x1B, dec_r16, 1, 2, 2, RegisterType::REG_DE},
+    {"INC E", 0x1C, inc_r8, 1, 1, 1, RegisterType::REG_E},
+    {"DEC E", 0x1D, dec_r8, 1, 1, 1, RegisterType::REG_E},
+    {"LD E, d8", 0x1E, ld_r8_d8, 2, 2, 2, RegisterType::REG_E},
+    {"RRA", 0x1F, rra, 1, 1, 1},
+
+    {"JR NZ, s8", 0x20, jr_nz_s8, 2, 2, 3},
+    {"LD HL, d16", 0x21, ld_r16_d16, 3, 3, 3, RegisterType::REG_HL},
+    {"LD (HL+), A", 0x22, ldi_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_A},
+    {"INC HL", 0x23, inc_r16, 1, 2, 2, RegisterType::REG_HL},
+    {"INC H", 0x24, inc_r8, 1, 1, 1, RegisterType::REG_H},
+    {"DEC H", 0x25, dec_r8, 1, 1, 1, RegisterType::REG_H},
+    {"LD H, d8", 0x26, ld_r8_d8, 2, 2, 2, RegisterType::REG_H},
+    {"DAA", 0x27, daa, 1, 1, 1},
+    {"JR Z, s8", 0x28, jr_z_s8, 2, 2, 3},
+    {"ADD HL, HL", 0x29, add_r16_r16, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_HL},
+    {"LD A, (HL+)", 0x2A, ldi_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"DEC HL", 0x2B, dec_r16, 1, 2, 2, RegisterType::REG_HL},
+    {"INC L", 0x2C, inc_r8, 1, 1, 1, RegisterType::REG_L},
+    {"DEC L", 0x2D, dec_r8, 1, 1, 1, RegisterType::REG_L},
+    {"LD L, d8", 0x2E, ld_r8_d8, 2, 2, 2, RegisterType::REG_L},
+    {"CPL", 0x2F, cpl, 1, 1, 1},
+
+    {"JR NC, s8", 0x30, jr_nc_s8, 2, 2, 3},
+    {"LD SP, d16", 0x31, ld_r16_d16, 3, 3, 3, RegisterType::REG_SP},
+    {"LD (HL-), A", 0x32, ldd_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_A},
+    {"INC SP", 0x33, inc_r16, 1, 2, 2, RegisterType::REG_SP},
+    {"INC (HL)", 0x34, inc_m16, 1, 3, 3, RegisterType::REG_HL},
+    {"DEC (HL)", 0x35, dec_m16, 1, 3, 3, RegisterType::REG_HL},
+    {"LD (HL), d8", 0x36, ld_m16_d8, 2, 3, 3, RegisterType::REG_HL},
+    {"SCF", 0x37, scf, 1, 1, 1},
+    {"JR C, s8", 0x38, jr_c_s8, 2, 2, 3},
+    {"ADD HL, SP", 0x39, add_r16_r16, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_SP},
+    {"LD A, (HL-)", 0x3A, ldd_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"DEC SP", 0x3B, dec_r16, 1, 2, 2, RegisterType::REG_SP},
+    {"INC A", 0x3C, inc_r8, 1, 1, 1, RegisterType::REG_A},
+    {"DEC A", 0x3D, dec_r8, 1, 1, 1, RegisterType::REG_A},
+    {"LD A, d8", 0x3E, ld_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"CCF", 0x3F, ccf, 1, 1, 1},
+
+    {"LD B, B", 0x40, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_B},
+    {"LD B, C", 0x41, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_C},
+    {"LD B, D", 0x42, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_D},
+    {"LD B, E", 0x43, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_E},
+    {"LD B, H", 0x44, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_H},
+    {"LD B, L", 0x45, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_L},
+    {"LD B, (HL)", 0x46, ld_r8_m16, 1, 2, 2, RegisterType::REG_B, RegisterType::REG_HL},
+    {"LD B, A", 0x47, ld_r8_r8, 1, 1, 1, RegisterType::REG_B, RegisterType::REG_A},
+
+    {"LD C, B", 0x48, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_B},
+    {"LD C, C", 0x49, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_C},
+    {"LD C, D", 0x4A, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_D},
+    {"LD C, E", 0x4B, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_E},
+    {"LD C, H", 0x4C, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_H},
+    {"LD C, L", 0x4D, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_L},
+    {"LD C, (HL)", 0x4E, ld_r8_m16, 1, 2, 2, RegisterType::REG_C, RegisterType::REG_HL},
+    {"LD C, A", 0x4F, ld_r8_r8, 1, 1, 1, RegisterType::REG_C, RegisterType::REG_A},
+
+    {"LD D, B", 0x50, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_B},
+    {"LD D, C", 0x51, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_C},
+    {"LD D, D", 0x52, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_D},
+    {"LD D, E", 0x53, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_E},
+    {"LD D, H", 0x54, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_H},
+    {"LD D, L", 0x55, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_L},
+    {"LD D, (HL)", 0x56, ld_r8_m16, 1, 2, 2, RegisterType::REG_D, RegisterType::REG_HL},
+    {"LD D, A", 0x57, ld_r8_r8, 1, 1, 1, RegisterType::REG_D, RegisterType::REG_A},
+
+    {"LD E, B", 0x58, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_B},
+    {"LD E, C", 0x59, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_C},
+    {"LD E, D", 0x5A, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_D},
+    {"LD E, E", 0x5B, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_E},
+    {"LD E, H", 0x5C, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_H},
+    {"LD E, L", 0x5D, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_L},
+    {"LD E, (HL)", 0x5E, ld_r8_m16, 1, 2, 2, RegisterType::REG_E, RegisterType::REG_HL},
+    {"LD E, A", 0x5F, ld_r8_r8, 1, 1, 1, RegisterType::REG_E, RegisterType::REG_A},
+
+    {"LD H, B", 0x60, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_B},
+    {"LD H, C", 0x61, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_C},
+    {"LD H, D", 0x62, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_D},
+    {"LD H, E", 0x63, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_E},
+    {"LD H, H", 0x64, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_H},
+    {"LD H, L", 0x65, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_L},
+    {"LD H, (HL)", 0x66, ld_r8_m16, 1, 2, 2, RegisterType::REG_H, RegisterType::REG_HL},
+    {"LD H, A", 0x67, ld_r8_r8, 1, 1, 1, RegisterType::REG_H, RegisterType::REG_A},
+
+    {"LD L, B", 0x68, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_B},
+    {"LD L, C", 0x69, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_C},
+    {"LD L, D", 0x6A, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_D},
+    {"LD L, E", 0x6B, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_E},
+    {"LD L, H", 0x6C, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_H},
+    {"LD L, L", 0x6D, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_L},
+    {"LD L, (HL)", 0x6E, ld_r8_m16, 1, 2, 2, RegisterType::REG_L, RegisterType::REG_HL},
+    {"LD L, A", 0x6F, ld_r8_r8, 1, 1, 1, RegisterType::REG_L, RegisterType::REG_A},
+
+    {"LD (HL), B", 0x70, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_B},
+    {"LD (HL), C", 0x71, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_C},
+    {"LD (HL), D", 0x72, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_D},
+    {"LD (HL), E", 0x73, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_E},
+    {"LD (HL), H", 0x74, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_H},
+    {"LD (HL), L", 0x75, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_L},
+    {"HALT", 0x76, halt, 1, 1, 1},
+    {"LD (HL), A", 0x77, ld_m16_r8, 1, 2, 2, RegisterType::REG_HL, RegisterType::REG_A},
+
+    {"LD A, B", 0x78, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"LD A, C", 0x79, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"LD A, D", 0x7A, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"LD A, E", 0x7B, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"LD A, H", 0x7C, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"LD A, L", 0x7D, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"LD A, (HL)", 0x7E, ld_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"LD A, A", 0x7F, ld_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"ADD A, B", 0x80, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"ADD A, C", 0x81, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"ADD A, D", 0x82, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"ADD A, E", 0x83, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"ADD A, H", 0x84, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"ADD A, L", 0x85, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"ADD A, (HL)", 0x86, add_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"ADD A, A", 0x87, add_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"ADC A, B", 0x88, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"ADC A, C", 0x89, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"ADC A, D", 0x8A, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"ADC A, E", 0x8B, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"ADC A, H", 0x8C, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"ADC A, L", 0x8D, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"ADC A, (HL)", 0x8E, adc_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"ADC A, A", 0x8F, adc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"SUB A, B", 0x90, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"SUB A, C", 0x91, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"SUB A, D", 0x92, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"SUB A, E", 0x93, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"SUB A, H", 0x94, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"SUB A, L", 0x95, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"SUB A, (HL)", 0x96, sub_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"SUB A, A", 0x97, sub_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"SBC A, B", 0x98, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"SBC A, C", 0x99, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"SBC A, D", 0x9A, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"SBC A, E", 0x9B, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"SBC A, H", 0x9C, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"SBC A, L", 0x9D, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"SBC A, (HL)", 0x9E, sbc_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"SBC A, A", 0x9F, sbc_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"AND A, B", 0xA0, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"AND A, C", 0xA1, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"AND A, D", 0xA2, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"AND A, E", 0xA3, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"AND A, H", 0xA4, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"AND A, L", 0xA5, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"AND A, (HL)", 0xA6, and_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"AND A, A", 0xA7, and_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"XOR A, B", 0xA8, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"XOR A, C", 0xA9, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"XOR A, D", 0xAA, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"XOR A, E", 0xAB, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"XOR A, H", 0xAC, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"XOR A, L", 0xAD, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"XOR A, (HL)", 0xAE, xor_r8_r16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"XOR A, A", 0xAF, xor_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"OR A, B", 0xB0, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"OR A, C", 0xB1, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"OR A, D", 0xB2, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"OR A, E", 0xB3, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"OR A, H", 0xB4, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"OR A, L", 0xB5, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"OR A, (HL)", 0xB6, or_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"OR A, A", 0xB7, or_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"CP A, B", 0xB8, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_B},
+    {"CP A, C", 0xB9, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_C},
+    {"CP A, D", 0xBA, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_D},
+    {"CP A, E", 0xBB, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_E},
+    {"CP A, H", 0xBC, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_H},
+    {"CP A, L", 0xBD, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_L},
+    {"CP A, (HL)", 0xBE, cp_r8_m16, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_HL},
+    {"CP A, A", 0xBF, cp_r8_r8, 1, 1, 1, RegisterType::REG_A, RegisterType::REG_A},
+
+    {"RET NZ", 0xC0, ret_nz, 1, 2, 5},
+    {"POP BC", 0xC1, pop_r16, 1, 3, 3, RegisterType::REG_BC},
+    {"JP NZ, a16", 0xC2, jp_nz_a16, 3, 3, 4},
+    {"JP a16", 0xC3, jp_a16, 3, 4, 4},
+    {"CALL NZ, a16", 0xC4, call_nz_a16, 3, 3, 6},
+    {"PUSH BC", 0xC5, push_r16, 1, 4, 4, RegisterType::REG_BC},
+    {"ADD A, d8", 0xC6, add_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"RST 0", 0xC7, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x00},
+    {"RET Z", 0xC8, ret_z, 1, 2, 5},
+    {"RET", 0xC9, ret, 1, 4, 4},
+    {"JP Z, a16", 0xCA, jp_z_a16, 3, 3, 4},
+    {"CALL Z, a16", 0xCC, call_z_a16, 3, 3, 6},
+    {"CALL a16", 0xCD, call_a16, 3, 6, 6},
+    {"ADC A, d8", 0xCE, adc_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"RST 1", 0xCF, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x08},
+
+    {"RET NC", 0xD0, ret_nc, 1, 2, 5},
+    {"POP DE", 0xD1, pop_r16, 1, 3, 3, RegisterType::REG_DE},
+    {"JP NC, a16", 0xD2, jp_nc_a16, 3, 3, 4},
+    {"CALL NC, a16", 0xD4, call_nc_a16, 3, 3, 6},
+    {"PUSH DE", 0xD5, push_r16, 1, 4, 4, RegisterType::REG_DE},
+    {"SUB A, d8", 0xD6, sub_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"RST 2", 0xD7, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x10},
+    {"RET C", 0xD8, ret_c, 1, 2, 5},
+    {"RETI", 0xD9, reti, 1, 4, 4},
+    {"JP C, a16", 0xDA, jp_c_a16, 3, 3, 4},
+    {"CALL C, a16", 0xDC, call_c_a16, 3, 3, 6},
+    {"SBC A, d8", 0xDE, sbc_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"RST 3", 0xDF, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x18},
+
+    {"LD (a8), A", 0xE0, ld_imm8_r8, 2, 3, 3, RegisterType::REG_A},
+    {"POP HL", 0xE1, pop_r16, 1, 3, 3, RegisterType::REG_HL},
+    {"LD (C), A", 0xE2, ld_m8_r8, 1, 2, 2, RegisterType::REG_C, RegisterType::REG_A},
+    {"PUSH HL", 0xE5, push_r16, 1, 4, 4, RegisterType::REG_HL},
+    {"AND A, d8", 0xE6, and_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"RST 4", 0xE7, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x20},
+    {"ADD SP, s8", 0xE8, add_r16_s8, 2, 4, 4, RegisterType::REG_SP},
+    {"JP HL", 0xE9, jp_r16, 1, 1, 1, RegisterType::REG_HL},
+    {"LD (a16), A", 0xEA, ld_imm16_r8, 3, 4, 4, RegisterType::REG_A},
+    {"XOR A, d8", 0xEE, xor_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"RST 5", 0xEF, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x28},
+
+    {"LD A, (a8)", 0xF0, ld_r8_imm8, 2, 3, 3, RegisterType::REG_A},
+    {"POP AF", 0xF1, pop_r16, 1, 3, 3, RegisterType::REG_AF},
+    {"LD A, (C)", 0xF2, ld_r8_m8, 1, 2, 2, RegisterType::REG_A, RegisterType::REG_C},
+    {"DI", 0xF3, di, 1, 1, 1},
+    {"PUSH AF", 0xF5, push_r16, 1, 4, 4, RegisterType::REG_AF},
+    {"OR A, d8", 0xF6, or_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"RST 6", 0xF7, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x30},
+    {"LD HL, SP+s8", 0xF8, ld_r16_r16_s8, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_SP},
+    {"LD SP, HL", 0xF9, ld_r16_r16, 1, 2, 2, RegisterType::REG_SP, RegisterType::REG_HL},
+    {"LD A, (a16)", 0xFA, ld_r8_imm16, 3, 4, 4, RegisterType::REG_A},
+    {"EI", 0xFB, ei, 1, 1, 1},
+    {"CP A, d8", 0xFE, cp_r8_d8, 2, 2, 2, RegisterType::REG_A},
+    {"RST 7", 0xFF, rst, 1, 4, 4, RegisterType::REG_NONE, RegisterType::REG_NONE, 0x38},
 };
 
-InstructionDef* InstructionSet::prefix_instructions[INSTRUCTION_SET_SIZE] = {
-
-    new InstructionDef("RLC B", 0x00, rlc_r8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("RLC C", 0x01, rlc_r8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("RLC D", 0x02, rlc_r8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("RLC E", 0x03, rlc_r8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("RLC H", 0x04, rlc_r8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("RLC L", 0x05, rlc_r8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("RLC (HL)", 0x06, rlc_m16, 2, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("RLC A", 0x07, rlc_r8, 2, 2, 2, RegisterType::REG_A),
-
-    new InstructionDef("RRC B", 0x08, rrc_r8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("RRC C", 0x09, rrc_r8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("RRC D", 0x0A, rrc_r8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("RRC E", 0x0B, rrc_r8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("RRC H", 0x0C, rrc_r8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("RRC L", 0x0D, rrc_r8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("RRC (HL)", 0x0E, rrc_m16, 2, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("RRC A", 0x0F, rrc_r8, 2, 2, 2, RegisterType::REG_A),
-
-    new InstructionDef("RL B", 0x10, rl_r8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("RL C", 0x11, rl_r8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("RL D", 0x12, rl_r8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("RL E", 0x13, rl_r8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("RL H", 0x14, rl_r8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("RL L", 0x15, rl_r8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("RL (HL)", 0x16, rl_m16, 2, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("RL A", 0x17, rl_r8, 2, 2, 2, RegisterType::REG_A),
+static constexpr InstructionDef prefix_instructions[] = {
+
+    {"RLC B", 0x00, rlc_r8, 2, 2, 2, RegisterType::REG_B},
+    {"RLC C", 0x01, rlc_r8, 2, 2, 2, RegisterType::REG_C},
+    {"RLC D", 0x02, rlc_r8, 2, 2, 2, RegisterType::REG_D},
+    {"RLC E", 0x03, rlc_r8, 2, 2, 2, RegisterType::REG_E},
+    {"RLC H", 0x04, rlc_r8, 2, 2, 2, RegisterType::REG_H},
+    {"RLC L", 0x05, rlc_r8, 2, 2, 2, RegisterType::REG_L},
+    {"RLC (HL)", 0x06, rlc_m16, 2, 4, 4, RegisterType::REG_HL},
+    {"RLC A", 0x07, rlc_r8, 2, 2, 2, RegisterType::REG_A},
+
+    {"RRC B", 0x08, rrc_r8, 2, 2, 2, RegisterType::REG_B},
+    {"RRC C", 0x09, rrc_r8, 2, 2, 2, RegisterType::REG_C},
+    {"RRC D", 0x0A, rrc_r8, 2, 2, 2, RegisterType::REG_D},
+    {"RRC E", 0x0B, rrc_r8, 2, 2, 2, RegisterType::REG_E},
+    {"RRC H", 0x0C, rrc_r8, 2, 2, 2, RegisterType::REG_H},
+    {"RRC L", 0x0D, rrc_r8, 2, 2, 2, RegisterType::REG_L},
+    {"RRC (HL)", 0x0E, rrc_m16, 2, 4, 4, RegisterType::REG_HL},
+    {"RRC A", 0x0F, rrc_r8, 2, 2, 2, RegisterType::REG_A},
+
+    {"RL B", 0x10, rl_r8, 2, 2, 2, RegisterType::REG_B},
+    {"RL C", 0x11, rl_r8, 2, 2, 2, RegisterType::REG_C},
+    {"RL D", 0x12, rl_r8, 2, 2, 2, RegisterType::REG_D},
+    {"RL E", 0x13, rl_r8, 2, 2, 2, RegisterType::REG_E},
+    {"RL H", 0x14, rl_r8, 2, 2, 2, RegisterType::REG_H},
+    {"RL L", 0x15, rl_r8, 2, 2, 2, RegisterType::REG_L},
+    {"RL (HL)", 0x16, rl_m16, 2, 4, 4, RegisterType::REG_HL},
+    {"RL A", 0x17, rl_r8, 2, 2, 2, RegisterType::REG_A},
 
     // RR
-    new InstructionDef("RR B", 0x18, rr_r8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("RR C", 0x19, rr_r8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("RR D", 0x1A, rr_r8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("RR E", 0x1B, rr_r8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("RR H", 0x1C, rr_r8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("RR L", 0x1D, rr_r8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("RR (HL)", 0x1E, rr_m16, 2, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("RR A", 0x1F, rr_r8, 2, 2, 2, RegisterType::REG_A),
+    {"RR B", 0x18, rr_r8, 2, 2, 2, RegisterType::REG_B},
+    {"RR C", 0x19, rr_r8, 2, 2, 2, RegisterType::REG_C},
+    {"RR D", 0x1A, rr_r8, 2, 2, 2, RegisterType::REG_D},
+    {"RR E", 0x1B, rr_r8, 2, 2, 2, RegisterType::REG_E},
+    {"RR H", 0x1C, rr_r8, 2, 2, 2, RegisterType::REG_H},
+    {"RR L", 0x1D, rr_r8, 2, 2, 2, RegisterType::REG_L},
+    {"RR (HL)", 0x1E, rr_m16, 2, 4, 4, RegisterType::REG_HL},
+    {"RR A", 0x1F, rr_r8, 2, 2, 2, RegisterType::REG_A},
 
     // SLA
-    new InstructionDef("SLA B", 0x20, sla_r8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("SLA C", 0x21, sla_r8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("SLA D", 0x22, sla_r8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("SLA E", 0x23, sla_r8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("SLA H", 0x24, sla_r8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("SLA L", 0x25, sla_r8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("SLA (HL)", 0x26, sla_m16, 2, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("SLA A", 0x27, sla_r8, 2, 2, 2, RegisterType::REG_A),
+    {"SLA B", 0x20, sla_r8, 2, 2, 2, RegisterType::REG_B},
+    {"SLA C", 0x21, sla_r8, 2, 2, 2, RegisterType::REG_C},
+    {"SLA D", 0x22, sla_r8, 2, 2, 2, RegisterType::REG_D},
+    {"SLA E", 0x23, sla_r8, 2, 2, 2, RegisterType::REG_E},
+    {"SLA H", 0x24, sla_r8, 2, 2, 2, RegisterType::REG_H},
+    {"SLA L", 0x25, sla_r8, 2, 2, 2, RegisterType::REG_L},
+    {"SLA (HL)", 0x26, sla_m16, 2, 4, 4, RegisterType::REG_HL},
+    {"SLA A", 0x27, sla_r8, 2, 2, 2, RegisterType::REG_A},
 
     // SRA
-    new InstructionDef("SRA B", 0x28, sra_r8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("SRA C", 0x29, sra_r8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("SRA D", 0x2A, sra_r8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("SRA E", 0x2B, sra_r8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("SRA H", 0x2C, sra_r8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("SRA L", 0x2D, sra_r8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("SRA (HL)", 0x2E, sra_m16, 2, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("SRA A", 0x2F, sra_r8, 2, 2, 2, RegisterType::REG_A),
-
-    new InstructionDef("SWAP B", 0x30, swap_r8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("SWAP C", 0x31, swap_r8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("SWAP D", 0x32, swap_r8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("SWAP E", 0x33, swap_r8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("SWAP H", 0x34, swap_r8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("SWAP L", 0x35, swap_r8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("SWAP (HL)", 0x36, swap_m16, 2, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("SWAP A", 0x37, swap_r8, 2, 2, 2, RegisterType::REG_A),
-
-    new InstructionDef("SRL B", 0x38, srl_r8, 2, 2, 2, RegisterType::REG_B),
-    new InstructionDef("SRL C", 0x39, srl_r8, 2, 2, 2, RegisterType::REG_C),
-    new InstructionDef("SRL D", 0x3A, srl_r8, 2, 2, 2, RegisterType::REG_D),
-    new InstructionDef("SRL E", 0x3B, srl_r8, 2, 2, 2, RegisterType::REG_E),
-    new InstructionDef("SRL H", 0x3C, srl_r8, 2, 2, 2, RegisterType::REG_H),
-    new InstructionDef("SRL L", 0x3D, srl_r8, 2, 2, 2, RegisterType::REG_L),
-    new InstructionDef("SRL (HL)", 0x3E, srl_m16, 2, 4, 4, RegisterType::REG_HL),
-    new InstructionDef("SRL A", 0x3F, srl_r8, 2, 2, 2, RegisterType::REG_A),
+    {"SRA B", 0x28, sra_r8, 2, 2, 2, RegisterType::REG_B},
+    {"SRA C", 0x29, sra_r8, 2, 2, 2, RegisterType::REG_C},
+    {"SRA D", 0x2A, sra_r8, 2, 2, 2, RegisterType::REG_D},
+    {"SRA E", 0x2B, sra_r8, 2, 2, 2, RegisterType::REG_E},
+    {"SRA H", 0x2C, sra_r8, 2, 2, 2, RegisterType::REG_H},
+    {"SRA L", 0x2D, sra_r8, 2, 2, 2, RegisterType::REG_L},
+    {"SRA (HL)", 0x2E, sra_m16, 2, 4, 4, RegisterType::REG_HL},
+    {"SRA A", 0x2F, sra_r8, 2, 2, 2, RegisterType::REG_A},
+
+    {"SWAP B", 0x30, swap_r8, 2, 2, 2, RegisterType::REG_B},
+    {"SWAP C", 0x31, swap_r8, 2, 2, 2, RegisterType::REG_C},
+    {"SWAP D", 0x32, swap_r8, 2, 2, 2, RegisterType::REG_D},
+    {"SWAP E", 0x33, swap_r8, 2, 2, 2, RegisterType::REG_E},
+    {"SWAP H", 0x34, swap_r8, 2, 2, 2, RegisterType::REG_H},
+    {"SWAP L", 0x35, swap_r8, 2, 2, 2, RegisterType::REG_L},
+    {"SWAP (HL)", 0x36, swap_m16, 2, 4, 4, RegisterType::REG_HL},
+    {"SWAP A", 0x37, swap_r8, 2, 2, 2, RegisterType::REG_A},
+
+    {"SRL B", 0x38, srl_r8, 2, 2, 2, RegisterType::REG_B},
+    {"SRL C", 0x39, srl_r8, 2, 2, 2, RegisterType::REG_C},
+    {"SRL D", 0x3A, srl_r8, 2, 2, 2, RegisterType::REG_D},
+    {"SRL E", 0x3B, srl_r8, 2, 2, 2, RegisterType::REG_E},
+    {"SRL H", 0x3C, srl_r8, 2, 2, 2, RegisterType::REG_H},
+    {"SRL L", 0x3D, srl_r8, 2, 2, 2, RegisterType::REG_L},
+    {"SRL (HL)", 0x3E, srl_m16, 2, 4, 4, RegisterType::REG_HL},
+    {"SRL A", 0x3F, srl_r8, 2, 2, 2, RegisterType::REG_A},
 
     // BIT 0
-    new InstructionDef("BIT 0, B", 0x40, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 0),
-    new InstructionDef("BIT 0, C", 0x41, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 0),
-    new InstructionDef("BIT 0, D", 0x42, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 0),
-    new InstructionDef("BIT 0, E", 0x43, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 0),
-    new InstructionDef("BIT 0, H", 0x44, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 0),
-    new InstructionDef("BIT 0, L", 0x45, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 0),
-    new InstructionDef("BIT 0, (HL)", 0x46, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 0),
-    new InstructionDef("BIT 0, A", 0x47, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 0),
+    {"BIT 0, B", 0x40, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 0},
+    {"BIT 0, C", 0x41, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 0},
+    {"BIT 0, D", 0x42, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 0},
+    {"BIT 0, E", 0x43, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 0},
+    {"BIT 0, H", 0x44, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 0},
+    {"BIT 0, L", 0x45, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 0},
+    {"BIT 0, (HL)", 0x46, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 0},
+    {"BIT 0, A", 0x47, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 0},
 
     // BIT 1
-    new InstructionDef("BIT 1, B", 0x48, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 1),
-    new InstructionDef("BIT 1, C", 0x49, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 1),
-    new InstructionDef("BIT 1, D", 0x4A, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 1),
-    new InstructionDef("BIT 1, E", 0x4B, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 1),
-    new InstructionDef("BIT 1, H", 0x4C, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 1),
-    new InstructionDef("BIT 1, L", 0x4D, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 1),
-    new InstructionDef("BIT 1, (HL)", 0x4E, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 1),
-    new InstructionDef("BIT 1, A", 0x4F, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 1),
+    {"BIT 1, B", 0x48, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 1},
+    {"BIT 1, C", 0x49, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 1},
+    {"BIT 1, D", 0x4A, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 1},
+    {"BIT 1, E", 0x4B, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 1},
+    {"BIT 1, H", 0x4C, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 1},
+    {"BIT 1, L", 0x4D, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 1},
+    {"BIT 1, (HL)", 0x4E, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 1},
+    {"BIT 1, A", 0x4F, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 1},
 
     // BIT 2
-    new InstructionDef("BIT 2, B", 0x50, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 2),
-    new InstructionDef("BIT 2, C", 0x51, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 2),
-    new InstructionDef("BIT 2, D", 0x52, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 2),
-    new InstructionDef("BIT 2, E", 0x53, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 2),
-    new InstructionDef("BIT 2, H", 0x54, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 2),
-    new InstructionDef("BIT 2, L", 0x55, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 2),
-    new InstructionDef("BIT 2, (HL)", 0x56, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 2),
-    new InstructionDef("BIT 2, A", 0x57, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 2),
+    {"BIT 2, B", 0x50, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 2},
+    {"BIT 2, C", 0x51, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 2},
+    {"BIT 2, D", 0x52, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 2},
+    {"BIT 2, E", 0x53, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 2},
+    {"BIT 2, H", 0x54, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 2},
+    {"BIT 2, L", 0x55, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 2},
+    {"BIT 2, (HL)", 0x56, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 2},
+    {"BIT 2, A", 0x57, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 2},
 
     // BIT 3
-    new InstructionDef("BIT 3, B", 0x58, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 3),
-    new InstructionDef("BIT 3, C", 0x59, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 3),
-    new InstructionDef("BIT 3, D", 0x5A, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 3),
-    new InstructionDef("BIT 3, E", 0x5B, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 3),
-    new InstructionDef("BIT 3, H", 0x5C, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 3),
-    new InstructionDef("BIT 3, L", 0x5D, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 3),
-    new InstructionDef("BIT 3, (HL)", 0x5E, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 3),
-    new InstructionDef("BIT 3, A", 0x5F, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 3),
+    {"BIT 3, B", 0x58, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 3},
+    {"BIT 3, C", 0x59, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 3},
+    {"BIT 3, D", 0x5A, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 3},
+    {"BIT 3, E", 0x5B, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 3},
+    {"BIT 3, H", 0x5C, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 3},
+    {"BIT 3, L", 0x5D, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 3},
+    {"BIT 3, (HL)", 0x5E, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 3},
+    {"BIT 3, A", 0x5F, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 3},
 
     // BIT 4
-    new InstructionDef("BIT 4, B", 0x60, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 4),
-    new InstructionDef("BIT 4, C", 0x61, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 4),
-    new InstructionDef("BIT 4, D", 0x62, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 4),
-    new InstructionDef("BIT 4, E", 0x63, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 4),
-    new InstructionDef("BIT 4, H", 0x64, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 4),
-    new InstructionDef("BIT 4, L", 0x65, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 4),
-    new InstructionDef("BIT 4, (HL)", 0x66, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 4),
-    new InstructionDef("BIT 4, A", 0x67, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 4),
+    {"BIT 4, B", 0x60, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 4},
+    {"BIT 4, C", 0x61, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 4},
+    {"BIT 4, D", 0x62, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 4},
+    {"BIT 4, E", 0x63, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 4},
+    {"BIT 4, H", 0x64, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 4},
+    {"BIT 4, L", 0x65, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 4},
+    {"BIT 4, (HL)", 0x66, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 4},
+    {"BIT 4, A", 0x67, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 4},
 
     // BIT 5
-    new InstructionDef("BIT 5, B", 0x68, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 5),
-    new InstructionDef("BIT 5, C", 0x69, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 5),
-    new InstructionDef("BIT 5, D", 0x6A, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 5),
-    new InstructionDef("BIT 5, E", 0x6B, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 5),
-    new InstructionDef("BIT 5, H", 0x6C, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 5),
-    new InstructionDef("BIT 5, L", 0x6D, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 5),
-    new InstructionDef("BIT 5, (HL)", 0x6E, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 5),
-    new InstructionDef("BIT 5, A", 0x6F, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 5),
+    {"BIT 5, B", 0x68, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 5},
+    {"BIT 5, C", 0x69, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 5},
+    {"BIT 5, D", 0x6A, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 5},
+    {"BIT 5, E", 0x6B, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 5},
+    {"BIT 5, H", 0x6C, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 5},
+    {"BIT 5, L", 0x6D, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 5},
+    {"BIT 5, (HL)", 0x6E, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 5},
+    {"BIT 5, A", 0x6F, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 5},
 
     // BIT 6
-    new InstructionDef("BIT 6, B", 0x70, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 6),
-    new InstructionDef("BIT 6, C", 0x71, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 6),
-    new InstructionDef("BIT 6, D", 0x72, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 6),
-    new InstructionDef("BIT 6, E", 0x73, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 6),
-    new InstructionDef("BIT 6, H", 0x74, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 6),
-    new InstructionDef("BIT 6, L", 0x75, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 6),
-    new InstructionDef("BIT 6, (HL)", 0x76, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 6),
-    new InstructionDef("BIT 6, A", 0x77, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 6),
+    {"BIT 6, B", 0x70, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 6},
+    {"BIT 6, C", 0x71, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 6},
+    {"BIT 6, D", 0x72, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 6},
+    {"BIT 6, E", 0x73, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 6},
+    {"BIT 6, H", 0x74, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 6},
+    {"BIT 6, L", 0x75, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 6},
+    {"BIT 6, (HL)", 0x76, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 6},
+    {"BIT 6, A", 0x77, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 6},
 
     // BIT 7
-    new InstructionDef("BIT 7, B", 0x78, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 7),
-    new InstructionDef("BIT 7, C", 0x79, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 7),
-    new InstructionDef("BIT 7, D", 0x7A, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 7),
-    new InstructionDef("BIT 7, E", 0x7B, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 7),
-    new InstructionDef("BIT 7, H", 0x7C, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 7),
-    new InstructionDef("BIT 7, L", 0x7D, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 7),
-    new InstructionDef("BIT 7, (HL)", 0x7E, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 7),
-    new InstructionDef("BIT 7, A", 0x7F, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 7),
+    {"BIT 7, B", 0x78, bit_imm_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 7},
+    {"BIT 7, C", 0x79, bit_imm_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 7},
+    {"BIT 7, D", 0x7A, bit_imm_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 7},
+    {"BIT 7, E", 0x7B, bit_imm_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 7},
+    {"BIT 7, H", 0x7C, bit_imm_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 7},
+    {"BIT 7, L", 0x7D, bit_imm_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 7},
+    {"BIT 7, (HL)", 0x7E, bit_imm_m16, 2, 3, 3, RegisterType::REG_HL, RegisterType::REG_NONE, 7},
+    {"BIT 7, A", 0x7F, bit_imm_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 7},
 
     // RES 0
-    new InstructionDef("RES 0, B", 0x80, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 0),
-    new InstructionDef("RES 0, C", 0x81, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 0),
-    new InstructionDef("RES 0, D", 0x82, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 0),
-    new InstructionDef("RES 0, E", 0x83, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 0),
-    new InstructionDef("RES 0, H", 0x84, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 0),
-    new InstructionDef("RES 0, L", 0x85, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 0),
-    new InstructionDef("RES 0, (HL)", 0x86, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 0),
-    new InstructionDef("RES 0, A", 0x87, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 0),
+    {"RES 0, B", 0x80, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 0},
+    {"RES 0, C", 0x81, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 0},
+    {"RES 0, D", 0x82, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 0},
+    {"RES 0, E", 0x83, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 0},
+    {"RES 0, H", 0x84, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 0},
+    {"RES 0, L", 0x85, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 0},
+    {"RES 0, (HL)", 0x86, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 0},
+    {"RES 0, A", 0x87, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 0},
 
     // RES 1
-    new InstructionDef("RES 1, B", 0x88, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 1),
-    new InstructionDef("RES 1, C", 0x89, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 1),
-    new InstructionDef("RES 1, D", 0x8A, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 1),
-    new InstructionDef("RES 1, E", 0x8B, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 1),
-    new InstructionDef("RES 1, H", 0x8C, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 1),
-    new InstructionDef("RES 1, L", 0x8D, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 1),
-    new InstructionDef("RES 1, (HL)", 0x8E, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 1),
-    new InstructionDef("RES 1, A", 0x8F, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 1),
+    {"RES 1, B", 0x88, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 1},
+    {"RES 1, C", 0x89, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 1},
+    {"RES 1, D", 0x8A, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 1},
+    {"RES 1, E", 0x8B, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 1},
+    {"RES 1, H", 0x8C, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 1},
+    {"RES 1, L", 0x8D, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 1},
+    {"RES 1, (HL)", 0x8E, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 1},
+    {"RES 1, A", 0x8F, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 1},
 
     // RES 2
-    new InstructionDef("RES 2, B", 0x90, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 2),
-    new InstructionDef("RES 2, C", 0x91, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 2),
-    new InstructionDef("RES 2, D", 0x92, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 2),
-    new InstructionDef("RES 2, E", 0x93, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 2),
-    new InstructionDef("RES 2, H", 0x94, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 2),
-    new InstructionDef("RES 2, L", 0x95, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 2),
-    new InstructionDef("RES 2, (HL)", 0x96, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 2),
-    new InstructionDef("RES 2, A", 0x97, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 2),
+    {"RES 2, B", 0x90, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 2},
+    {"RES 2, C", 0x91, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 2},
+    {"RES 2, D", 0x92, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 2},
+    {"RES 2, E", 0x93, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 2},
+    {"RES 2, H", 0x94, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 2},
+    {"RES 2, L", 0x95, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 2},
+    {"RES 2, (HL)", 0x96, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 2},
+    {"RES 2, A", 0x97, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 2},
 
     // RES 3
-    new InstructionDef("RES 3, B", 0x98, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 3),
-    new InstructionDef("RES 3, C", 0x99, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 3),
-    new InstructionDef("RES 3, D", 0x9A, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 3),
-    new InstructionDef("RES 3, E", 0x9B, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 3),
-    new InstructionDef("RES 3, H", 0x9C, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 3),
-    new InstructionDef("RES 3, L", 0x9D, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 3),
-    new InstructionDef("RES 3, (HL)", 0x9E, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 3),
-    new InstructionDef("RES 3, A", 0x9F, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 3),
+    {"RES 3, B", 0x98, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 3},
+    {"RES 3, C", 0x99, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 3},
+    {"RES 3, D", 0x9A, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 3},
+    {"RES 3, E", 0x9B, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 3},
+    {"RES 3, H", 0x9C, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 3},
+    {"RES 3, L", 0x9D, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 3},
+    {"RES 3, (HL)", 0x9E, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 3},
+    {"RES 3, A", 0x9F, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 3},
 
     // RES 4
-    new InstructionDef("RES 4, B", 0xA0, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 4),
-    new InstructionDef("RES 4, C", 0xA1, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 4),
-    new InstructionDef("RES 4, D", 0xA2, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 4),
-    new InstructionDef("RES 4, E", 0xA3, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 4),
-    new InstructionDef("RES 4, H", 0xA4, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 4),
-    new InstructionDef("RES 4, L", 0xA5, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 4),
-    new InstructionDef("RES 4, (HL)", 0xA6, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 4),
-    new InstructionDef("RES 4, A", 0xA7, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 4),
+    {"RES 4, B", 0xA0, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 4},
+    {"RES 4, C", 0xA1, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 4},
+    {"RES 4, D", 0xA2, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 4},
+    {"RES 4, E", 0xA3, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 4},
+    {"RES 4, H", 0xA4, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 4},
+    {"RES 4, L", 0xA5, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 4},
+    {"RES 4, (HL)", 0xA6, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 4},
+    {"RES 4, A", 0xA7, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 4},
 
     // RES 5
-    new InstructionDef("RES 5, B", 0xA8, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 5),
-    new InstructionDef("RES 5, C", 0xA9, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 5),
-    new InstructionDef("RES 5, D", 0xAA, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 5),
-    new InstructionDef("RES 5, E", 0xAB, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 5),
-    new InstructionDef("RES 5, H", 0xAC, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 5),
-    new InstructionDef("RES 5, L", 0xAD, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 5),
-    new InstructionDef("RES 5, (HL)", 0xAE, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 5),
-    new InstructionDef("RES 5, A", 0xAF, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 5),
+    {"RES 5, B", 0xA8, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 5},
+    {"RES 5, C", 0xA9, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 5},
+    {"RES 5, D", 0xAA, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 5},
+    {"RES 5, E", 0xAB, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 5},
+    {"RES 5, H", 0xAC, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 5},
+    {"RES 5, L", 0xAD, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 5},
+    {"RES 5, (HL)", 0xAE, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 5},
+    {"RES 5, A", 0xAF, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 5},
 
     // RES 6
-    new InstructionDef("RES 6, B", 0xB0, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 6),
-    new InstructionDef("RES 6, C", 0xB1, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 6),
-    new InstructionDef("RES 6, D", 0xB2, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 6),
-    new InstructionDef("RES 6, E", 0xB3, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 6),
-    new InstructionDef("RES 6, H", 0xB4, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 6),
-    new InstructionDef("RES 6, L", 0xB5, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 6),
-    new InstructionDef("RES 6, (HL)", 0xB6, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 6),
-    new InstructionDef("RES 6, A", 0xB7, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 6),
+    {"RES 6, B", 0xB0, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 6},
+    {"RES 6, C", 0xB1, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 6},
+    {"RES 6, D", 0xB2, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 6},
+    {"RES 6, E", 0xB3, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 6},
+    {"RES 6, H", 0xB4, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 6},
+    {"RES 6, L", 0xB5, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 6},
+    {"RES 6, (HL)", 0xB6, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 6},
+    {"RES 6, A", 0xB7, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 6},
 
     // RES 7
-    new InstructionDef("RES 7, B", 0xB8, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 7),
-    new InstructionDef("RES 7, C", 0xB9, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 7),
-    new InstructionDef("RES 7, D", 0xBA, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 7),
-    new InstructionDef("RES 7, E", 0xBB, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 7),
-    new InstructionDef("RES 7, H", 0xBC, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 7),
-    new InstructionDef("RES 7, L", 0xBD, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 7),
-    new InstructionDef("RES 7, (HL)", 0xBE, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 7),
-    new InstructionDef("RES 7, A", 0xBF, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 7),
+    {"RES 7, B", 0xB8, res_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 7},
+    {"RES 7, C", 0xB9, res_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 7},
+    {"RES 7, D", 0xBA, res_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 7},
+    {"RES 7, E", 0xBB, res_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 7},
+    {"RES 7, H", 0xBC, res_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 7},
+    {"RES 7, L", 0xBD, res_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 7},
+    {"RES 7, (HL)", 0xBE, res_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 7},
+    {"RES 7, A", 0xBF, res_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 7},
 
     // SET 0
-    new InstructionDef("SET 0, B", 0xC0, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 0),
-    new InstructionDef("SET 0, C", 0xC1, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 0),
-    new InstructionDef("SET 0, D", 0xC2, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 0),
-    new InstructionDef("SET 0, E", 0xC3, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 0),
-    new InstructionDef("SET 0, H", 0xC4, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 0),
-    new InstructionDef("SET 0, L", 0xC5, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 0),
-    new InstructionDef("SET 0, (HL)", 0xC6, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 0),
-    new InstructionDef("SET 0, A", 0xC7, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 0),
+    {"SET 0, B", 0xC0, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 0},
+    {"SET 0, C", 0xC1, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 0},
+    {"SET 0, D", 0xC2, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 0},
+    {"SET 0, E", 0xC3, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 0},
+    {"SET 0, H", 0xC4, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 0},
+    {"SET 0, L", 0xC5, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 0},
+    {"SET 0, (HL)", 0xC6, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 0},
+    {"SET 0, A", 0xC7, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 0},
 
     // SET 1
-    new InstructionDef("SET 1, B", 0xC8, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 1),
-    new InstructionDef("SET 1, C", 0xC9, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 1),
-    new InstructionDef("SET 1, D", 0xCA, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 1),
-    new InstructionDef("SET 1, E", 0xCB, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 1),
-    new InstructionDef("SET 1, H", 0xCC, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 1),
-    new InstructionDef("SET 1, L", 0xCD, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 1),
-    new InstructionDef("SET 1, (HL)", 0xCE, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 1),
-    new InstructionDef("SET 1, A", 0xCF, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 1),
+    {"SET 1, B", 0xC8, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 1},
+    {"SET 1, C", 0xC9, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 1},
+    {"SET 1, D", 0xCA, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 1},
+    {"SET 1, E", 0xCB, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 1},
+    {"SET 1, H", 0xCC, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 1},
+    {"SET 1, L", 0xCD, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 1},
+    {"SET 1, (HL)", 0xCE, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 1},
+    {"SET 1, A", 0xCF, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 1},
 
     // SET 2
-    new InstructionDef("SET 2, B", 0xD0, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 2),
-    new InstructionDef("SET 2, C", 0xD1, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 2),
-    new InstructionDef("SET 2, D", 0xD2, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 2),
-    new InstructionDef("SET 2, E", 0xD3, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 2),
-    new InstructionDef("SET 2, H", 0xD4, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 2),
-    new InstructionDef("SET 2, L", 0xD5, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 2),
-    new InstructionDef("SET 2, (HL)", 0xD6, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 2),
-    new InstructionDef("SET 2, A", 0xD7, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 2),
+    {"SET 2, B", 0xD0, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 2},
+    {"SET 2, C", 0xD1, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 2},
+    {"SET 2, D", 0xD2, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 2},
+    {"SET 2, E", 0xD3, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 2},
+    {"SET 2, H", 0xD4, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 2},
+    {"SET 2, L", 0xD5, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 2},
+    {"SET 2, (HL)", 0xD6, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 2},
+    {"SET 2, A", 0xD7, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 2},
 
     // SET 3
-    new InstructionDef("SET 3, B", 0xD8, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 3),
-    new InstructionDef("SET 3, C", 0xD9, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 3),
-    new InstructionDef("SET 3, D", 0xDA, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 3),
-    new InstructionDef("SET 3, E", 0xDB, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 3),
-    new InstructionDef("SET 3, H", 0xDC, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 3),
-    new InstructionDef("SET 3, L", 0xDD, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 3),
-    new InstructionDef("SET 3, (HL)", 0xDE, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 3),
-    new InstructionDef("SET 3, A", 0xDF, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 3),
+    {"SET 3, B", 0xD8, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 3},
+    {"SET 3, C", 0xD9, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 3},
+    {"SET 3, D", 0xDA, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 3},
+    {"SET 3, E", 0xDB, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 3},
+    {"SET 3, H", 0xDC, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 3},
+    {"SET 3, L", 0xDD, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 3},
+    {"SET 3, (HL)", 0xDE, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 3},
+    {"SET 3, A", 0xDF, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 3},
 
     // SET 4
-    new InstructionDef("SET 4, B", 0xE0, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 4),
-    new InstructionDef("SET 4, C", 0xE1, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 4),
-    new InstructionDef("SET 4, D", 0xE2, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 4),
-    new InstructionDef("SET 4, E", 0xE3, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 4),
-    new InstructionDef("SET 4, H", 0xE4, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 4),
-    new InstructionDef("SET 4, L", 0xE5, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 4),
-    new InstructionDef("SET 4, (HL)", 0xE6, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 4),
-    new InstructionDef("SET 4, A", 0xE7, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 4),
+    {"SET 4, B", 0xE0, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 4},
+    {"SET 4, C", 0xE1, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 4},
+    {"SET 4, D", 0xE2, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 4},
+    {"SET 4, E", 0xE3, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 4},
+    {"SET 4, H", 0xE4, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 4},
+    {"SET 4, L", 0xE5, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 4},
+    {"SET 4, (HL)", 0xE6, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 4},
+    {"SET 4, A", 0xE7, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 4},
 
     // SET 5
-    new InstructionDef("SET 5, B", 0xE8, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 5),
-    new InstructionDef("SET 5, C", 0xE9, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 5),
-    new InstructionDef("SET 5, D", 0xEA, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 5),
-    new InstructionDef("SET 5, E", 0xEB, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 5),
-    new InstructionDef("SET 5, H", 0xEC, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 5),
-    new InstructionDef("SET 5, L", 0xED, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 5),
-    new InstructionDef("SET 5, (HL)", 0xEE, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 5),
-    new InstructionDef("SET 5, A", 0xEF, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 5),
+    {"SET 5, B", 0xE8, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 5},
+    {"SET 5, C", 0xE9, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 5},
+    {"SET 5, D", 0xEA, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 5},
+    {"SET 5, E", 0xEB, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 5},
+    {"SET 5, H", 0xEC, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 5},
+    {"SET 5, L", 0xED, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 5},
+    {"SET 5, (HL)", 0xEE, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 5},
+    {"SET 5, A", 0xEF, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 5},
 
     // SET 6
-    new InstructionDef("SET 6, B", 0xF0, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 6),
-    new InstructionDef("SET 6, C", 0xF1, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 6),
-    new InstructionDef("SET 6, D", 0xF2, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 6),
-    new InstructionDef("SET 6, E", 0xF3, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 6),
-    new InstructionDef("SET 6, H", 0xF4, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 6),
-    new InstructionDef("SET 6, L", 0xF5, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 6),
-    new InstructionDef("SET 6, (HL)", 0xF6, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 6),
-    new InstructionDef("SET 6, A", 0xF7, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 6),
+    {"SET 6, B", 0xF0, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 6},
+    {"SET 6, C", 0xF1, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 6},
+    {"SET 6, D", 0xF2, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 6},
+    {"SET 6, E", 0xF3, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 6},
+    {"SET 6, H", 0xF4, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 6},
+    {"SET 6, L", 0xF5, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 6},
+    {"SET 6, (HL)", 0xF6, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 6},
+    {"SET 6, A", 0xF7, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 6},
 
     // SET 7
-    new InstructionDef("SET 7, B", 0xF8, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 7),
-    new InstructionDef("SET 7, C", 0xF9, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 7),
-    new InstructionDef("SET 7, D", 0xFA, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 7),
-    new InstructionDef("SET 7, E", 0xFB, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 7),
-    new InstructionDef("SET 7, H", 0xFC, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 7),
-    new InstructionDef("SET 7, L", 0xFD, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 7),
-    new InstructionDef("SET 7, (HL)", 0xFE, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 7),
-    new InstructionDef("SET 7, A", 0xFF, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 7),
+    {"SET 7, B", 0xF8, set_bit_r8, 2, 2, 2, RegisterType::REG_B, RegisterType::REG_NONE, 7},
+    {"SET 7, C", 0xF9, set_bit_r8, 2, 2, 2, RegisterType::REG_C, RegisterType::REG_NONE, 7},
+    {"SET 7, D", 0xFA, set_bit_r8, 2, 2, 2, RegisterType::REG_D, RegisterType::REG_NONE, 7},
+    {"SET 7, E", 0xFB, set_bit_r8, 2, 2, 2, RegisterType::REG_E, RegisterType::REG_NONE, 7},
+    {"SET 7, H", 0xFC, set_bit_r8, 2, 2, 2, RegisterType::REG_H, RegisterType::REG_NONE, 7},
+    {"SET 7, L", 0xFD, set_bit_r8, 2, 2, 2, RegisterType::REG_L, RegisterType::REG_NONE, 7},
+    {"SET 7, (HL)", 0xFE, set_bit_m16, 2, 4, 4, RegisterType::REG_HL, RegisterType::REG_NONE, 7},
+    {"SET 7, A", 0xFF, set_bit_r8, 2, 2, 2, RegisterType::REG_A, RegisterType::REG_NONE, 7},
 };
 
-static InstructionDef* instr_lut[256] = {};
-static InstructionDef* prefix_instr_lut[256] = {};
-
-void InstructionSet::Initialize()
+// indexed by opcode, opcodes without an instruction stay null
+template <size_t N>
+static constexpr std::array<const InstructionDef*, INSTRUCTION_SET_SIZE> BuildLookup(const InstructionDef (&defs)[N])
 {
-    for (int i = 0; i < INSTRUCTION_SET_SIZE; i++)
-    {
-        if (instructions[i])
-            instr_lut[instructions[i]->opcode] = instructions[i];
+    std::array<const InstructionDef*, INSTRUCTION_SET_SIZE> lookup = {};
+    for (const InstructionDef& def : defs)
+        lookup[def.opcode] = &def;
 
-        if (prefix_instructions[i])
-            prefix_instr_lut[prefix_instructions[i]->opcode] = prefix_instructions[i];
-    }
+    return lookup;
 }
 
-InstructionDef* InstructionSet::Get(uint8_t opcode)
+static constexpr auto instr_lut = BuildLookup(instructions);
+static constexpr auto prefix_instr_lut = BuildLookup(prefix_instructions);
+
+const InstructionDef* InstructionSet::Get(uint8_t opcode)
 {
     return instr_lut[opcode];
 }
 
-InstructionDef* InstructionSet::GetPrefixed(uint8_t opcode)
+const InstructionDef* InstructionSet::GetPrefixed(uint8_t opcode)
 {
     return prefix_instr_lut[opcode];
 }
@@ -3,14 +3,10 @@
 
 #define INSTRUCTION_SET_SIZE 0x100
 
+// the tables are built at compile time, nothing here is set up at runtime
 class InstructionSet
 {
 public:
-    static void Initialize();
-    static InstructionDef* Get(uint8_t opcode);
-    static InstructionDef* GetPrefixed(uint8_t opcode);
-
-private:
-    static InstructionDef* instructions[INSTRUCTION_SET_SIZE];
-    static InstructionDef* prefix_instructions[INSTRUCTION_SET_SIZE];
+    static const InstructionDef* Get(uint8_t opcode);
+    static const InstructionDef* GetPrefixed(uint8_t opcode);
 };
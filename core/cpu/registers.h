@@ -2,13 +2,13 @@
 
 #include <cstdint>
 
-#define REGISTER(hi, lo)  \
-    union {               \
-        struct {          \
-            uint8_t lo;   \
-            uint8_t hi;   \
-        };                \
-        uint16_t hi##lo;  \
+#define REGISTER(hi, lo)     \
+    union {                  \
+        struct {             \
+            uint8_t lo;      \
+            uint8_t hi;      \
+        };                   \
+        uint16_t hi##lo = 0; \
     }
 
 #define FLAG_MASK_Z 0b10000000
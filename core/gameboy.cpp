@@ -1,82 +1,310 @@
 #include "gameboy.h"
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <cstdio>
+#include <cstring>
+
+// ppu t-cycles in a frame, the same at either cpu speed
+static constexpr int32_t frame_tcycles =
+    static_cast<int32_t>((CLOCK_RATE / T_CYCLES_PER_M_CYCLE) / FRAMES_PER_SECOND) * T_CYCLES_PER_M_CYCLE;
 
 GameBoy::GameBoy(const std::string& rom_path, GameBoySettings settings)
+    : ppu(settings.framebuffer, settings.palette)
 {
-    this->cpu = new CPU();
-    this->memory = new Memory();
-    this->cartridge = new Cartridge();
-    this->ppu = new PPU(settings.framebuffer, settings.palette);
-    this->input = new Input();
-    this->timer = new Timer();
-    this->apu = new APU();
-
     if (!rom_path.empty())
-        this->cartridge->LoadRom(rom_path);
+        this->cartridge.LoadRom(rom_path, settings.map_rom);
+
+    // everything sized by the cartridge comes out of one allocation, cgb mode needs a
+    // cgb cartridge so a dmg game never pays for the extra banks
+    const bool cgb = this->cartridge.HasCGBSupport();
+    const size_t memory_offset = this->arena.Reserve(Memory::GetBufferSize(cgb));
+    const size_t ram_offset = this->arena.Reserve(this->cartridge.GetRamBufferSize());
+    const size_t framebuffer_offset = settings.framebuffer == nullptr
+        ? this->arena.Reserve(SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t))
+        : 0;
+    this->arena.Allocate();
+
+    this->memory.AttachBuffer(this->arena.Get(memory_offset), cgb);
+    this->cartridge.AttachRam(this->arena.Get(ram_offset));
+    if (settings.framebuffer == nullptr)
+        this->ppu.framebuffer = reinterpret_cast<uint16_t*>(this->arena.Get(framebuffer_offset));
 
-    this->memory->AttachCartridge(this->cartridge);
-    this->memory->AttachCPU(this->cpu);
+    this->memory.AttachCartridge(&this->cartridge);
+    this->memory.AttachCPU(&this->cpu);
 
-    this->cpu->AttachMemory(this->memory);
-    this->ppu->AttachMemory(this->memory);
-    this->input->AttachMemory(this->memory);
-    this->timer->AttachMemory(this->memory);
-    this->apu->AttachMemory(this->memory);
+    this->cpu.AttachMemory(&this->memory);
+    this->ppu.AttachMemory(&this->memory);
+    this->input.AttachMemory(&this->memory);
+    this->timer.AttachMemory(&this->memory);
+    this->apu.AttachMemory(&this->memory);
+    this->apu.SetSampleRate(settings.sample_rate);
+    this->serial.AttachMemory(&this->memory);
+
+    if (settings.threaded_rendering)
+        this->ppu.EnableRenderWorker();
+
+    this->memory.stats.Reset();
 }
 
 
 void GameBoy::TickFrame()
 {
-    int frame_mcycles = static_cast<int>((CLOCK_RATE / T_CYCLES_PER_M_CYCLE) / FRAMES_PER_SECOND);
+    PollInput();
+
+    if (this->run_ahead_frames == 0 || this->serial.IsLinked())
+    {
+        RunFrame(true, false);
+        return;
+    }
+
+    // the real frame is heard but not seen, the picture comes from run_ahead_frames further on
+    // with the same input. only the presented frame and the one before it, which draws its
+    // first lines, are rendered
+    this->ppu.skip_rendering = this->run_ahead_frames > 1;
+    RunFrame(false, false);
+
+    SaveState(this->run_ahead_state, false);
+
+    // speculative frames hold the current input like they would live, a movie being
+    // played picks up again from the rollback
+    this->next_movie_cycle = UINT64_MAX;
+
+    // nobody hears a speculative frame, the rollback puts the channels back
+    this->apu.SetMuted(true);
+
+    for (int i = 1; i <= this->run_ahead_frames; i++)
+    {
+        this->ppu.skip_rendering = i < this->run_ahead_frames - 1;
+        RunFrame(i == this->run_ahead_frames, true);
+    }
+
+    this->ppu.skip_rendering = false;
+    this->apu.SetMuted(this->audio_muted);
+    LoadState(this->run_ahead_state.data(), this->run_ahead_state.size());
+}
+
+void GameBoy::RunFrame(bool present, bool speculative)
+{
+    GameBoyStats& stats = memory.stats;
+    PROFILE_SCOPE(stats, TIMER_FRAME);
+    PROFILE_LAP_BEGIN(stats);
 
-    while (frame_mcycles > 0)
+    // the budget is in ppu time, a cpu in double speed gets twice the m-cycles out of a frame
+    int frame_cycles = frame_tcycles;
+
+    while (frame_cycles > 0)
     {
-        const int mcycles = cpu->Cycle();
-        const int tcycles = mcycles * T_CYCLES_PER_M_CYCLE;
+        if (cpu.cycles >= this->next_movie_cycle) [[unlikely]]
+            PlayMovieEvents();
+
+        if (frame_tcycles - frame_cycles >= this->next_input_offset) [[unlikely]]
+            ApplyFrameInput(frame_tcycles - frame_cycles);
+
+        const int mcycles = cpu.Cycle();
+        const int cpu_tcycles = mcycles * T_CYCLES_PER_M_CYCLE;
+        const int tcycles = cpu_tcycles >> cpu.double_speed;
 
-        frame_mcycles -= mcycles;
+        frame_cycles -= tcycles;
+        PROFILE_LAP(TIMER_CPU);
 
-        ppu->Cycle(tcycles);
-        apu->Cycle(tcycles);
-        timer->Cycle(tcycles);
+        ppu.Cycle(tcycles);
+        PROFILE_LAP(TIMER_PPU);
 
-        if (ppu->ready_for_draw)
+        apu.Cycle(tcycles);
+        PROFILE_LAP(TIMER_APU);
+
+        timer.Cycle(cpu_tcycles);
+        serial.Cycle(cpu_tcycles, tcycles);
+        PROFILE_LAP(TIMER_TIMER);
+
+        if (ppu.ready_for_draw)
         {
-            on_draw_function(ppu->framebuffer);
-            ppu->ready_for_draw = false;
+            ppu.ready_for_draw = false;
+
+            // the samples mixed so far belong to this frame
+            OutputAudio(speculative);
+            PROFILE_LAP(TIMER_AUDIO_CALLBACK);
+
+            if (present)
+            {
+                ppu.PresentFrame();
+                if (this->hash_log)
+                    this->hash_log->AddFrame(ppu.framebuffer, SCREEN_WIDTH * SCREEN_HEIGHT);
+
+                if (this->latency_monitor) [[unlikely]]
+                    this->latency_monitor->FrameDrawn(ppu.dirty_rows.Any(), GetHostTime());
+
+                on_draw_function(ppu.framebuffer);
+                PROFILE_LAP(TIMER_DRAW_CALLBACK);
+            }
+
+            if (!speculative && this->rewind_buffer && this->rewind_buffer->FrameDone())
+                RecordRewindState();
         }
 
-        if (apu->ready_for_samples)
+        if (apu.ready_for_samples)
         {
-            float left, right;
-            apu->GetSamples(left, right);
-            on_audio_function(left, right);
-            apu->ready_for_samples = false;
+            OutputAudio(speculative);
+            PROFILE_LAP(TIMER_AUDIO_CALLBACK);
+        }
+
+        if (serial.ready_for_output) [[unlikely]]
+        {
+            serial.ready_for_output = false;
+
+            // a rolled back frame sends the same bytes again
+            if (!speculative && on_serial_function)
+                on_serial_function(serial.output);
         }
     }
+
+    // the last instruction can run past the offset of a change that came in late
+    if (this->frame_input_position < this->frame_input_count)
+        ApplyFrameInput(frame_tcycles);
+
+    OutputAudio(speculative);
+    PROFILE_LAP(TIMER_AUDIO_CALLBACK);
+
+    stats.frames++;
+}
+
+void GameBoy::OutputAudio(bool speculative)
+{
+    const AudioSample* left;
+    const AudioSample* right;
+    const size_t count = apu.TakeSamples(left, right);
+
+    // a rolled back frame is heard when it runs again
+    if (speculative)
+        return;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (this->hash_log)
+            this->hash_log->AddSample(left[i], right[i]);
+
+        on_audio_function(left[i], right[i]);
+    }
 }
 
 bool GameBoy::IsCGBGame()
 {
-    return this->cartridge->HasCGBSupport();
+    return this->cartridge.HasCGBSupport();
 }
 
 void GameBoy::LoadBootRom(const std::string& boot_rom_path)
 {
-    this->memory->LoadBootRom(boot_rom_path);
-    this->ppu->use_cgb_rendering = this->memory->IsCGB();
+    this->memory.LoadBootRom(boot_rom_path);
+    this->ppu.use_cgb_rendering = this->memory.IsCGB();
+}
+
+void GameBoy::PressButton(InputButton button, int64_t host_ns)
+{
+    this->input_queue.Push({button, true, host_ns, 0});
+}
+
+void GameBoy::ReleaseButton(InputButton button, int64_t host_ns)
+{
+    this->input_queue.Push({button, false, host_ns, 0});
 }
 
-void GameBoy::PressButton(InputButton button)
+int64_t GameBoy::GetHostTime()
 {
-    this->input->PressButton(button);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-void GameBoy::ReleaseButton(InputButton button)
+// spreads what came in since the last poll over the frame about to run, in the order it was sent
+void GameBoy::PollInput()
 {
-    this->input->ReleaseButton(button);
+    this->frame_input_count = 0;
+    this->frame_input_position = 0;
+
+    ButtonEvent event;
+    while (this->frame_input_count < INPUT_QUEUE_CAPACITY && this->input_queue.Pop(event))
+    {
+        // a movie being played owns the pad
+        if (this->movie_mode != MovieMode::MOVIE_PLAYING)
+            this->frame_input[this->frame_input_count++] = event;
+    }
+
+    // read once the queue is empty, so everything taken was stamped before it
+    const int64_t now = GetHostTime();
+    const int64_t window = now - this->last_input_poll_ns;
+    int32_t offset = 0;
+
+    for (size_t i = 0; i < this->frame_input_count; i++)
+    {
+        ButtonEvent& pending = this->frame_input[i];
+
+        // the first frame has no window to measure against
+        if (pending.host_ns != INPUT_TIME_NONE && this->last_input_poll_ns != 0 && window > 0)
+        {
+            const int64_t since = std::clamp<int64_t>(pending.host_ns - this->last_input_poll_ns, 0, window);
+            offset = std::max(offset, static_cast<int32_t>(since * (frame_tcycles - 1) / window));
+        }
+
+        pending.frame_offset = offset;
+    }
+
+    this->last_input_poll_ns = now;
+    this->next_input_offset = this->frame_input_count > 0 ? this->frame_input[0].frame_offset : INT32_MAX;
+}
+
+void GameBoy::ApplyFrameInput(int32_t frame_offset)
+{
+    for (; this->frame_input_position < this->frame_input_count &&
+           this->frame_input[this->frame_input_position].frame_offset <= frame_offset;
+         this->frame_input_position++)
+    {
+        const ButtonEvent& event = this->frame_input[this->frame_input_position];
+        if (event.pressed)
+            this->input.PressButton(event.button);
+        else
+            this->input.ReleaseButton(event.button);
+
+        if (this->movie_mode == MovieMode::MOVIE_RECORDING)
+            this->movie.AddEvent(this->cpu.cycles, event.button, event.pressed);
+
+        if (this->latency_monitor && event.pressed && event.host_ns != INPUT_TIME_NONE) [[unlikely]]
+            this->latency_monitor->InputApplied(event.host_ns, GetHostTime());
+    }
+
+    this->next_input_offset = this->frame_input_position < this->frame_input_count
+                                  ? this->frame_input[this->frame_input_position].frame_offset
+                                  : INT32_MAX;
+}
+
+const DirtyRows& GameBoy::GetDirtyRows() const
+{
+    return this->ppu.dirty_rows;
+}
+
+const GameBoyStats& GameBoy::GetStats() const
+{
+    return this->memory.stats;
+}
+
+void GameBoy::ResetStats()
+{
+    this->memory.stats.Reset();
+}
+
+void GameBoy::EnableExecutionProfile(bool enable)
+{
+    if (!GameBoyStats::ENABLED || !enable)
+    {
+        this->cpu.execution_profile = nullptr;
+        return;
+    }
+
+    if (!this->cpu.execution_profile)
+        this->cpu.execution_profile = std::make_unique<ExecutionProfile>(this->cartridge.GetRomBankCount());
+}
+
+const ExecutionProfile* GameBoy::GetExecutionProfile() const
+{
+    return this->cpu.execution_profile.get();
 }
 
 void GameBoy::OnDraw(const DrawFunction onDraw)
@@ -89,12 +317,279 @@ void GameBoy::OnAudio(const AudioFunction onAudio)
     this->on_audio_function = onAudio;
 }
 
+uint32_t GameBoy::GetSampleRate() const
+{
+    return this->apu.GetSampleRate();
+}
+
+void GameBoy::SetAudioMuted(bool muted)
+{
+    this->audio_muted = muted;
+    this->apu.SetMuted(muted);
+}
+
+void GameBoy::OnSerial(const SerialFunction onSerial)
+{
+    this->on_serial_function = onSerial;
+}
+
+void GameBoy::ConnectLink(SerialTransport* transport)
+{
+    this->serial.AttachTransport(transport);
+}
+
+uint8_t GameBoy::ReadMemory(uint16_t address)
+{
+    return this->memory.Read8(address);
+}
+
 void GameBoy::ReadSave(const char* path)
 {
-    this->cartridge->ReadSave(path);
+    this->cartridge.ReadSave(path);
 }
 
 void GameBoy::WriteSave(const char* path)
 {
-    this->cartridge->WriteSave(path);
-}
\ No newline at end of file
+    this->cartridge.WriteSave(path);
+}
+
+void GameBoy::SaveState(std::vector<uint8_t>& buffer, bool include_framebuffer) const
+{
+    buffer.clear();
+    StateWriter writer(buffer);
+
+    SaveStateHeader header = {
+        .magic = SAVE_STATE_MAGIC,
+        .version = SAVE_STATE_VERSION,
+        .size = 0,
+        .rom_checksum = this->cartridge.GetChecksum(),
+        .flags = (include_framebuffer ? SAVE_STATE_FLAG_FRAMEBUFFER : 0u) | SAVE_STATE_BUILD_FLAGS,
+    };
+    memcpy(header.title, this->cartridge.GetTitle(), sizeof(header.title));
+    writer.Write(header);
+
+    this->cpu.SaveState(writer);
+    this->memory.SaveState(writer);
+    this->cartridge.SaveState(writer);
+    this->ppu.SaveState(writer, include_framebuffer);
+    this->apu.SaveState(writer);
+    this->timer.SaveState(writer);
+    this->serial.SaveState(writer);
+    this->input.SaveState(writer);
+
+    header.size = static_cast<uint32_t>(writer.Size());
+    memcpy(writer.Data(), &header, sizeof(header));
+}
+
+bool GameBoy::LoadState(const uint8_t* data, size_t size)
+{
+    SaveStateHeader header = {};
+    if (size < sizeof(header))
+        return false;
+
+    memcpy(&header, data, sizeof(header));
+
+    // everything is checked up front, a blob that passes here loads completely
+    if (header.magic != SAVE_STATE_MAGIC || header.version != SAVE_STATE_VERSION || header.size != size ||
+        header.rom_checksum != this->cartridge.GetChecksum() ||
+        (header.flags & SAVE_STATE_FLAG_FIXED_AUDIO) != (SAVE_STATE_BUILD_FLAGS & SAVE_STATE_FLAG_FIXED_AUDIO))
+    {
+        return false;
+    }
+
+    StateReader reader(data + sizeof(header), size - sizeof(header));
+
+    this->cpu.LoadState(reader);
+    this->memory.LoadState(reader);
+    this->cartridge.LoadState(reader);
+    this->ppu.LoadState(reader, header.flags & SAVE_STATE_FLAG_FRAMEBUFFER);
+    this->apu.LoadState(reader);
+    this->timer.LoadState(reader);
+    this->serial.LoadState(reader);
+    this->input.LoadState(reader);
+
+    SyncMovie();
+
+    return reader.Ok() && reader.AtEnd();
+}
+
+bool GameBoy::SaveStateFile(const std::string& path) const
+{
+    std::vector<uint8_t> buffer;
+    SaveState(buffer);
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    const size_t written = fwrite(buffer.data(), 1, buffer.size(), file);
+    fclose(file);
+
+    return written == buffer.size();
+}
+
+bool GameBoy::LoadStateFile(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    rewind(file);
+
+    std::vector<uint8_t> buffer(size > 0 ? size : 0);
+    const size_t bytes_read = fread(buffer.data(), 1, buffer.size(), file);
+    fclose(file);
+
+    return bytes_read == buffer.size() && LoadState(buffer.data(), buffer.size());
+}
+
+void GameBoy::EnableRewind(size_t capacity, int interval)
+{
+    if (capacity == 0)
+    {
+        this->rewind_buffer = nullptr;
+        this->rewind_state = {};
+        return;
+    }
+
+    this->rewind_buffer = std::make_unique<RewindBuffer>(capacity, interval);
+}
+
+bool GameBoy::Rewind()
+{
+    if (!this->rewind_buffer || !this->rewind_buffer->Pop(this->rewind_state))
+        return false;
+
+    return LoadState(this->rewind_state.data(), this->rewind_state.size());
+}
+
+void GameBoy::RecordRewindState()
+{
+    // taken right after the frame was handed out, so the framebuffer is redrawn before it is
+    // seen again. a scrolling screen changes nearly every pixel and would dominate the deltas
+    SaveState(this->rewind_state, false);
+    this->rewind_buffer->Push(this->rewind_state.data(), this->rewind_state.size());
+}
+
+const RewindBuffer* GameBoy::GetRewindBuffer() const
+{
+    return this->rewind_buffer.get();
+}
+
+void GameBoy::SetRunAhead(int frames)
+{
+    this->run_ahead_frames = std::clamp(frames, 0, RUN_AHEAD_MAX_FRAMES);
+}
+
+void GameBoy::StartMovieRecording()
+{
+    this->movie.Clear();
+    SaveState(this->movie.start_state);
+
+    this->movie_mode = MovieMode::MOVIE_RECORDING;
+    this->next_movie_cycle = UINT64_MAX;
+}
+
+bool GameBoy::SaveMovie(const std::string& path) const
+{
+    return this->movie_mode == MovieMode::MOVIE_RECORDING && this->movie.Save(path);
+}
+
+bool GameBoy::PlayMovie(const std::string& path)
+{
+    Movie loaded;
+    if (!loaded.Load(path))
+        return false;
+
+    this->movie = std::move(loaded);
+    this->movie_mode = MovieMode::MOVIE_PLAYING;
+
+    // loading the start state also seeks to the first event
+    if (!LoadState(this->movie.start_state.data(), this->movie.start_state.size()))
+    {
+        StopMovie();
+        return false;
+    }
+
+    return true;
+}
+
+void GameBoy::StopMovie()
+{
+    this->movie_mode = MovieMode::MOVIE_NONE;
+    this->movie.Clear();
+    this->movie_position = 0;
+    this->next_movie_cycle = UINT64_MAX;
+}
+
+bool GameBoy::IsMovieFinished() const
+{
+    return this->movie_mode == MovieMode::MOVIE_PLAYING && this->movie_position >= this->movie.events.size();
+}
+
+void GameBoy::PlayMovieEvents()
+{
+    const std::vector<MovieEvent>& events = this->movie.events;
+
+    for (; this->movie_position < events.size() && events[this->movie_position].cycle <= this->cpu.cycles;
+         this->movie_position++)
+    {
+        const MovieEvent& event = events[this->movie_position];
+        if (event.pressed)
+            this->input.PressButton(event.button);
+        else
+            this->input.ReleaseButton(event.button);
+    }
+
+    this->next_movie_cycle = this->movie_position < events.size() ? events[this->movie_position].cycle : UINT64_MAX;
+}
+
+// the cpu cycle counter is part of the state, so after a load it says where the movie stands
+void GameBoy::SyncMovie()
+{
+    if (this->movie_mode == MovieMode::MOVIE_RECORDING)
+    {
+        this->movie.Truncate(this->cpu.cycles);
+    }
+    else if (this->movie_mode == MovieMode::MOVIE_PLAYING)
+    {
+        this->movie_position = this->movie.Find(this->cpu.cycles);
+        this->next_movie_cycle = this->movie_position < this->movie.events.size()
+                                     ? this->movie.events[this->movie_position].cycle
+                                     : UINT64_MAX;
+    }
+}
+
+void GameBoy::EnableHashLog(bool enable)
+{
+    if (!enable)
+        this->hash_log = nullptr;
+    else if (!this->hash_log)
+        this->hash_log = std::make_unique<FrameHashLog>();
+}
+
+const FrameHashLog* GameBoy::GetHashLog() const
+{
+    return this->hash_log.get();
+}
+
+void GameBoy::EnableLatencyMonitor(bool enable)
+{
+    if (!enable)
+        this->latency_monitor = nullptr;
+    else if (!this->latency_monitor)
+        this->latency_monitor = std::make_unique<LatencyMonitor>();
+}
+
+const LatencyMonitor* GameBoy::GetLatencyMonitor() const
+{
+    return this->latency_monitor.get();
+}
+
+void GameBoy::FramePresented()
+{
+    if (this->latency_monitor)
+        this->latency_monitor->FramePresented(GetHostTime());
+}
@@ -5,14 +5,31 @@
 #include "cpu/cpu.h"
 #include "memory/memory.h"
 #include "memory/cartridge.h"
+#include "memory/arena.h"
 #include "graphics/ppu.h"
 #include "io/input.h"
+#include "io/serial.h"
+#include "io/link_cable.h"
+#include "io/spsc_queue.h"
+#include "profiling/latency.h"
 #include "timer/timer.h"
+#include "state/save_state.h"
+#include "state/rewind.h"
+#include "state/movie.h"
+#include "state/hash_log.h"
 
 #define GB_COLOR(r, g, b) ((uint16_t)((((b) * 31 / 255) & 0x1F) << 10 | (((g) * 31 / 255) & 0x1F) << 5 | (((r) * 31 / 255) & 0x1F)))
 
+#define RUN_AHEAD_MAX_FRAMES 4
+
+// button changes the host can send between two frames, more are dropped
+#define INPUT_QUEUE_CAPACITY 64
+// a button change without a host time is applied right at the start of the next frame
+#define INPUT_TIME_NONE 0
+
 typedef std::function<void(uint16_t data[SCREEN_WIDTH * SCREEN_HEIGHT])> DrawFunction;
-typedef std::function<void(float left, float right)> AudioFunction;
+typedef std::function<void(AudioSample left, AudioSample right)> AudioFunction;
+typedef std::function<void(uint8_t byte)> SerialFunction;
 
 struct GameBoySettings
 {
@@ -23,6 +40,21 @@ struct GameBoySettings
         0x368F,
         0x1D67
     };
+    bool threaded_rendering = false;
+    // maps the rom file read-only instead of reading it, see RomCache
+    bool map_rom = false;
+    // samples per second handed to OnAudio, clamped to what the apu supports
+    uint32_t sample_rate = APU_DEFAULT_SAMPLE_RATE;
+};
+
+struct ButtonEvent
+{
+    InputButton button;
+    bool pressed;
+    // steady clock nanoseconds from GameBoy::GetHostTime
+    int64_t host_ns;
+    // ppu t-cycles into the frame it is applied in
+    int32_t frame_offset;
 };
 
 class GameBoy
@@ -35,25 +67,126 @@ public:
 
     void LoadBootRom(const std::string& boot_rom_path);
 
-    void PressButton(InputButton button);
-    void ReleaseButton(InputButton button);
+    // button changes go through a lock-free queue from one host thread at a time and are
+    // picked up at the start of the next frame. one stamped with its host time lands as far
+    // into that frame as it came into the frame before, so input lags by exactly one frame
+    // and keeps its spacing. without a time it lands on the first instruction
+    void PressButton(InputButton button, int64_t host_ns = INPUT_TIME_NONE);
+    void ReleaseButton(InputButton button, int64_t host_ns = INPUT_TIME_NONE);
+
+    // the clock button changes are stamped with
+    static int64_t GetHostTime();
+
+    const DirtyRows& GetDirtyRows() const;
+
+    // all zero unless the core is built with PESTO_GB_PROFILE
+    const GameBoyStats& GetStats() const;
+    void ResetStats();
+
+    // per opcode and per (bank, pc) histograms, null unless enabled in a PESTO_GB_PROFILE build
+    void EnableExecutionProfile(bool enable);
+    const ExecutionProfile* GetExecutionProfile() const;
 
     void OnDraw(DrawFunction onDraw);
     void OnAudio(AudioFunction onAudio);
+    uint32_t GetSampleRate() const;
+    // for headless runs and fast forward, OnAudio isn't called while muted
+    void SetAudioMuted(bool muted);
+    // every byte the game sends over the link port, nothing answers so it reads back 0xFF
+    void OnSerial(SerialFunction onSerial);
+
+    // plugs in a link cable, null unplugs it. the transport has to outlive the connection.
+    // run-ahead is skipped while linked, the other side can't take back what it was sent
+    void ConnectLink(SerialTransport* transport);
+
+    // reads the bus like the cpu would, for tools that look for results left in memory
+    uint8_t ReadMemory(uint16_t address);
 
     void ReadSave(const char* path);
     void WriteSave(const char* path);
 
+    // the buffer is overwritten, reusing it between calls avoids reallocating. a state taken
+    // right after a frame was drawn can leave out the framebuffer, the next frame redraws it
+    void SaveState(std::vector<uint8_t>& buffer, bool include_framebuffer = true) const;
+    bool LoadState(const uint8_t* data, size_t size);
+
+    bool SaveStateFile(const std::string& path) const;
+    bool LoadStateFile(const std::string& path);
+
+    // records a state every interval frames into a ring of capacity bytes, zero turns it off
+    void EnableRewind(size_t capacity, int interval = REWIND_DEFAULT_INTERVAL);
+    // steps back to the newest recorded state, false once the history is used up
+    bool Rewind();
+    const RewindBuffer* GetRewindBuffer() const;
+
+    // shows the frame this many frames ahead of the real one to hide input latency, 0 turns it off
+    void SetRunAhead(int frames);
+
+    // records button changes from the current state on, going back in time drops the
+    // events after the point returned to
+    void StartMovieRecording();
+    bool SaveMovie(const std::string& path) const;
+    // loads the movie's start state and plays its events back, host input is ignored meanwhile
+    bool PlayMovie(const std::string& path);
+    void StopMovie();
+    bool IsMovieFinished() const;
+
+    void EnableHashLog(bool enable);
+    const FrameHashLog* GetHashLog() const;
+
+    // times host presses stamped with GetHostTime until they show up, null unless enabled.
+    // turn it on before frames are presented from another thread
+    void EnableLatencyMonitor(bool enable);
+    const LatencyMonitor* GetLatencyMonitor() const;
+    // the frontend calls this once a drawn frame is on screen, from whichever thread shows it
+    void FramePresented();
 
 private:
-    CPU* cpu;
-    Memory* memory;
-    Cartridge* cartridge;
-    PPU* ppu;
-    APU* apu;
-    Input* input;
-    Timer* timer;
+    // declared first so it outlives every component pointing into it
+    Arena arena;
+
+    Cartridge cartridge;
+    Memory memory;
+    CPU cpu;
+    PPU ppu;
+    APU apu;
+    Input input;
+    Timer timer;
+    Serial serial;
 
     DrawFunction on_draw_function;
     AudioFunction on_audio_function;
+    SerialFunction on_serial_function;
+
+    std::unique_ptr<RewindBuffer> rewind_buffer;
+    std::vector<uint8_t> rewind_state;
+
+    int run_ahead_frames = 0;
+    bool audio_muted = false;
+    std::vector<uint8_t> run_ahead_state;
+
+    SpscQueue<ButtonEvent, INPUT_QUEUE_CAPACITY> input_queue;
+    // taken off the queue for this frame, applied between instructions once the frame
+    // gets to their offset
+    ButtonEvent frame_input[INPUT_QUEUE_CAPACITY] = {};
+    size_t frame_input_count = 0;
+    size_t frame_input_position = 0;
+    int32_t next_input_offset = INT32_MAX;
+    int64_t last_input_poll_ns = 0;
+
+    Movie movie;
+    MovieMode movie_mode = MovieMode::MOVIE_NONE;
+    size_t movie_position = 0;
+    uint64_t next_movie_cycle = UINT64_MAX;
+
+    std::unique_ptr<FrameHashLog> hash_log;
+    std::unique_ptr<LatencyMonitor> latency_monitor;
+
+    void RunFrame(bool present, bool speculative);
+    void OutputAudio(bool speculative);
+    void PollInput();
+    void ApplyFrameInput(int32_t frame_offset);
+    void PlayMovieEvents();
+    void SyncMovie();
+    void RecordRewindState();
 };
@@ -0,0 +1,109 @@
+#include "dirty_rows.h"
+#include <bit>
+#include <cstring>
+
+void DirtyRows::MarkAll()
+{
+    for (int row = 0; row < SCREEN_HEIGHT; row++)
+        Mark(row);
+}
+
+void DirtyRows::Clear()
+{
+    memset(this->bits, 0, sizeof(this->bits));
+}
+
+void DirtyRows::Merge(const DirtyRows& other)
+{
+    for (int i = 0; i < DIRTY_ROW_WORDS; i++)
+        this->bits[i] |= other.bits[i];
+}
+
+bool DirtyRows::Any() const
+{
+    for (const uint32_t word : this->bits)
+    {
+        if (word != 0)
+            return true;
+    }
+
+    return false;
+}
+
+int DirtyRows::Count() const
+{
+    int count = 0;
+    for (const uint32_t word : this->bits)
+        count += std::popcount(word);
+
+    return count;
+}
+
+bool DirtyRows::NextRange(int begin, int& range_begin, int& range_end) const
+{
+    int row = begin;
+    while (row < SCREEN_HEIGHT && !IsDirty(row))
+        row++;
+
+    if (row >= SCREEN_HEIGHT)
+        return false;
+
+    range_begin = row;
+    while (row < SCREEN_HEIGHT && IsDirty(row))
+        row++;
+
+    range_end = row;
+    return true;
+}
+
+DirtyRowTracker::DirtyRowTracker()
+{
+    // nothing has been presented yet
+    this->dirty.MarkAll();
+}
+
+void DirtyRowTracker::Update(uint8_t row, const uint16_t* pixels)
+{
+    this->row_hashes[row] = HashRow(pixels);
+}
+
+// the framebuffer was replaced wholesale, rehash it
+void DirtyRowTracker::Reset(const uint16_t* framebuffer)
+{
+    for (int row = 0; row < SCREEN_HEIGHT; row++)
+        this->row_hashes[row] = HashRow(framebuffer + row * SCREEN_WIDTH);
+}
+
+// rows are compared against the last frame handed out rather than the last one drawn,
+// frames that are drawn but never shown (run-ahead, rewind) don't hide changes
+DirtyRows DirtyRowTracker::TakeFrame()
+{
+    DirtyRows frame = this->dirty;
+    this->dirty.Clear();
+
+    for (int row = 0; row < SCREEN_HEIGHT; row++)
+    {
+        if (this->row_hashes[row] != this->presented_hashes[row])
+        {
+            this->presented_hashes[row] = this->row_hashes[row];
+            frame.Mark(row);
+        }
+    }
+
+    return frame;
+}
+
+uint64_t DirtyRowTracker::HashRow(const uint16_t* pixels)
+{
+    uint64_t hash = 0x9E3779B97F4A7C15;
+
+    for (int i = 0; i < SCREEN_WIDTH; i += 4)
+    {
+        uint64_t word;
+        memcpy(&word, pixels + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001B3;
+        hash ^= hash >> 29;
+    }
+
+    return hash;
+}
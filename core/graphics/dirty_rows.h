@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+#include "scanline_renderer.h"
+
+#define DIRTY_ROW_WORDS ((SCREEN_HEIGHT + 31) / 32)
+
+// one bit per scanline that changed since the previous frame
+struct DirtyRows
+{
+    uint32_t bits[DIRTY_ROW_WORDS] = {};
+
+    bool IsDirty(int row) const { return (bits[row >> 5] >> (row & 31)) & 1; }
+    void Mark(int row) { bits[row >> 5] |= 1u << (row & 31); }
+
+    void MarkAll();
+    void Clear();
+    void Merge(const DirtyRows& other);
+
+    bool Any() const;
+    int Count() const;
+
+    // finds the next run of dirty rows at or after begin, end is exclusive
+    bool NextRange(int begin, int& range_begin, int& range_end) const;
+};
+
+class DirtyRowTracker
+{
+public:
+    DirtyRowTracker();
+
+    void Update(uint8_t row, const uint16_t* pixels);
+    void Reset(const uint16_t* framebuffer);
+    DirtyRows TakeFrame();
+
+private:
+    static uint64_t HashRow(const uint16_t* pixels);
+
+    uint64_t row_hashes[SCREEN_HEIGHT] = {};
+    uint64_t presented_hashes[SCREEN_HEIGHT] = {};
+    DirtyRows dirty = {};
+};
@@ -5,31 +5,18 @@
 
 #include "../cpu/cpu.h"
 
-static uint16_t tile_pixel_lut[256];
-static uint16_t tile_pixel_lut_flipped[256];
-
 PPU::PPU(uint16_t* framebuffer, std::array<uint16_t, 4> palette)
+    : renderer(palette)
 {
-    this->framebuffer = framebuffer != nullptr
-        ? framebuffer
-        : static_cast<uint16_t*>(malloc(SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t)));
+    this->framebuffer = framebuffer;
 
     this->dmg_palette = palette;
+}
 
-    // build tile pixel lut
-    for (int b = 0; b < 256; b++)
-    {
-        uint16_t forward = 0, reverse = 0;
-        for (int bit = 0; bit < 8; bit++)
-        {
-            const uint16_t v = (b >> (7 - bit)) & 1;
-            forward |= v << (bit << 1);
-            reverse |= v << ((7 - bit) << 1);
-        }
-
-        tile_pixel_lut[b] = forward;
-        tile_pixel_lut_flipped[b] = reverse;
-    }
+void PPU::EnableRenderWorker()
+{
+    this->render_worker = std::make_unique<RenderWorker>(this->framebuffer, this->dmg_palette, this->memory,
+                                                         &this->dirty_tracker);
 }
 
 void PPU::RebuildBGPaletteCache(uint8_t idx)
@@ -98,8 +85,9 @@ void PPU::Cycle(uint8_t cycles)
                 for (int i = 0; i < HDMA_BLOCK_SIZE; i++)
                     this->memory->WriteVRAM(this->hdma_dst + i, this->memory->Read8(this->hdma_src + i));
 
+                // the destination wraps around inside vram
                 this->hdma_src += HDMA_BLOCK_SIZE;
-                this->hdma_dst += HDMA_BLOCK_SIZE;
+                this->hdma_dst = (this->hdma_dst + HDMA_BLOCK_SIZE) & HDMA_DST_MASK;
                 this->hdma_bytes_left -= HDMA_BLOCK_SIZE;
 
                 if (this->hdma_bytes_left == 0)
@@ -115,6 +103,9 @@ void PPU::Cycle(uint8_t cycles)
 
             if (this->scanline > PPU_MAX_VISIBLE_SCANLINE)
             {
+                if (this->render_worker)
+                    this->render_worker->WaitIdle();
+
                 this->SetMode(PPUMode::MODE_VBLANK);
                 this->ready_for_draw = true;
                 this->memory->SetInterruptFlag(INTERRUPT_VBLANK);
@@ -155,9 +146,9 @@ void PPU::AttachMemory(Memory* mem)
 {
     this->memory = mem;
 
-    mem->RegisterIOHandler(0x47, 0x47, this, &PPU::PPURead, &PPU::PPUWrite);
-    mem->RegisterIOHandler(0x68, 0x6B, this, &PPU::PPURead, &PPU::PPUWrite);
-    mem->RegisterIOHandler(0x51, 0x55, this, &PPU::PPURead, &PPU::PPUWrite);
+    mem->RegisterIOHandler<&PPU::PPURead, &PPU::PPUWrite>(0x47, 0x47, this);
+    mem->RegisterIOHandler<&PPU::PPURead, &PPU::PPUWrite>(0x68, 0x6B, this);
+    mem->RegisterIOHandler<&PPU::PPURead, &PPU::PPUWrite>(0x51, 0x55, this);
 
     LCDC = mem->PtrIO(IO_ADDR_LCDC);
     STAT = mem->PtrIO(IO_ADDR_STAT);
@@ -227,8 +218,8 @@ void PPU::PPUWrite(uint8_t* io, uint16_t offset, uint8_t value)
 
     if (offset == IO_ADDR_HDMA5)
     {
-        const uint16_t src = (io[IO_ADDR_HDMA1] << 8 | io[IO_ADDR_HDMA2]) & 0xFFF0;
-        const uint16_t dst = (io[IO_ADDR_HDMA3] << 8 | io[IO_ADDR_HDMA4]) & 0x1FF0;
+        const uint16_t src = (io[IO_ADDR_HDMA1] << 8 | io[IO_ADDR_HDMA2]) & HDMA_SRC_MASK;
+        const uint16_t dst = (io[IO_ADDR_HDMA3] << 8 | io[IO_ADDR_HDMA4]) & HDMA_DST_MASK;
         const uint16_t len = ((value & 0x7F) + 1) * HDMA_BLOCK_SIZE;
 
         if ((value & HDMA5_TYPE_MASK) == 0)
@@ -240,7 +231,7 @@ void PPU::PPUWrite(uint8_t* io, uint16_t offset, uint8_t value)
                 return;
             }
             for (uint16_t i = 0; i < len; i++)
-                this->memory->WriteVRAM(dst + i, this->memory->Read8(src + i));
+                this->memory->WriteVRAM((dst + i) & HDMA_VRAM_MASK, this->memory->Read8(src + i));
             io[IO_ADDR_HDMA5] = HDMA_TRANSFER_COMPLETE;
         }
         else
@@ -286,12 +277,32 @@ void PPU::CheckLYC() const
 
 void PPU::RenderScanline()
 {
-    uint16_t* row = this->framebuffer + this->scanline * SCREEN_WIDTH;
+    if (this->skip_rendering)
+    {
+        // the window line counter is emulated state, it advances even when nothing is drawn
+        if (IsWindowVisible())
+            this->window_line++;
+
+        return;
+    }
+
+    PROFILE_SCOPE(memory->stats, TIMER_PPU_RENDER);
+    PROFILE_COUNT(memory->stats, COUNTER_SCANLINES);
 
-    memset(this->scanline_priority, 0, SCREEN_WIDTH);
-    memset(this->scanline_bg_priority, 0, SCREEN_WIDTH);
+    ScanlineState& state = this->render_worker ? this->render_worker->BeginJob() : this->scanline_state;
 
-    if (!use_cgb_rendering && this->bgp_event_count > 0)
+    state.scanline = this->scanline;
+    state.lcdc = *LCDC;
+    state.scy = *SCY;
+    state.scx = *SCX;
+    state.wx = *WX;
+    state.bgp = *BGP;
+    state.obp0 = *OBP0;
+    state.obp1 = *OBP1;
+    state.use_cgb_rendering = this->use_cgb_rendering;
+    state.use_bgp_snapshot = !use_cgb_rendering && this->bgp_event_count > 0;
+
+    if (state.use_bgp_snapshot)
     {
         memset(this->scanline_bgp, *BGP, SCREEN_WIDTH);
         for (int i = 0; i < this->bgp_event_count; i++)
@@ -305,281 +316,47 @@ void PPU::RenderScanline()
         }
     }
 
-    RenderBackground(row);
-    RenderWindow(row);
-    RenderObjects(row);
-}
-
-void PPU::RenderBackground(uint16_t* row)
-{
-    const uint8_t lcdc = *LCDC;
-
-    if ((lcdc & LCDC_BG_ENABLE) == 0 && !use_cgb_rendering)
-        return;
-
-    const uint8_t scy = *SCY;
-    const uint8_t scx = *SCX;
-
-    const uint16_t tile_map_base = (lcdc & LCDC_BG_TILEMAP) ? 0x1C00 : 0x1800;
-    const uint16_t tile_data_base = (lcdc & LCDC_TILE_DATA) ? 0x0000 : 0x1000;
-    const bool signed_tiles = !(lcdc & LCDC_TILE_DATA);
-
-    const uint8_t py = this->scanline + scy;
-    const uint8_t tile_y = py >> 3;
-    const uint8_t pixel_y = py & 7;
-
-    const uint8_t* vram0 = memory->VRAMPtr(false);
-    const uint8_t* vram1 = memory->VRAMPtr(true);
-
-    uint8_t tile_x = (scx >> 3) & 0x1F;
-    uint8_t pixel_x = scx & 7;
-    int screen_x = 0;
-
     if (use_cgb_rendering)
     {
-        auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
-        {
-            const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
-            const uint8_t tile_idx = vram0[map_off];
-            const uint8_t tile_attr = vram1[map_off];
-
-            const bool flip_x = tile_attr & OBJ_FLIP_X_MASK;
-            const bool flip_y = tile_attr & OBJ_FLIP_Y_MASK;
-            const bool has_bg_pri = tile_attr & OBJ_PRIORITY_MASK;
-            const bool use_bank1 = tile_attr & OBJ_BANK_MASK;
-
-            const uint8_t real_py = flip_y ? (7 - pixel_y) : pixel_y;
-            const uint16_t tile_addr = tile_data_base +
-                (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
-
-            const uint8_t* vsrc = use_bank1 ? vram1 : vram0;
-            const uint8_t td1 = vsrc[tile_addr + real_py * 2];
-            const uint8_t td2 = vsrc[tile_addr + real_py * 2 + 1];
-
-            const uint16_t* lut = flip_x ? tile_pixel_lut_flipped : tile_pixel_lut;
-            const uint16_t* pal = bg_palette_cache[tile_attr & OBJ_CGB_PALETTE_MASK];
-
-            uint16_t td = (lut[td1] | (lut[td2] << 1)) >> (pstart * 2);
-            for (int i = 0; i < count; i++, td >>= 2)
-            {
-                const uint8_t ci = td & 3;
-                row[sx + i] = pal[ci];
-                scanline_priority[sx + i] = ci;
-                scanline_bg_priority[sx + i] = has_bg_pri;
-            }
-        };
-
-        if (pixel_x != 0)
-        {
-            const int count = std::min((int)(TILE_PIXEL_SIZE - pixel_x), SCREEN_WIDTH);
-            render_tile(tile_x, screen_x, pixel_x, count);
-            screen_x += count;
-            tile_x = (tile_x + 1) & 0x1F;
-        }
-
-        while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
-        {
-            render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
-            screen_x += TILE_PIXEL_SIZE;
-            tile_x = (tile_x + 1) & 0x1F;
-        }
-
-        if (screen_x < SCREEN_WIDTH)
-            render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
+        memcpy(state.bg_palette_cache, this->bg_palette_cache, sizeof(this->bg_palette_cache));
+        memcpy(state.obj_palette_cache, this->obj_palette_cache, sizeof(this->obj_palette_cache));
     }
     else
     {
-        const uint8_t current_bgp = *BGP;
-        const bool use_bgp_snapshot = (this->bgp_event_count > 0);
-
-        if (use_bgp_snapshot)
-        {
-            auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
-            {
-                const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
-                const uint8_t tile_idx = vram0[map_off];
-                const uint16_t tile_addr = tile_data_base +
-                    (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
-
-                const uint8_t td1 = vram0[tile_addr + pixel_y * 2];
-                const uint8_t td2 = vram0[tile_addr + pixel_y * 2 + 1];
-                uint16_t td = (tile_pixel_lut[td1] | (tile_pixel_lut[td2] << 1)) >> (pstart * 2);
-
-                for (int i = 0; i < count; i++, td >>= 2)
-                {
-                    const uint8_t ci = td & 3;
-                    row[sx + i] = dmg_palette[(scanline_bgp[sx + i] >> (ci << 1)) & 3];
-                    scanline_priority[sx + i] = ci;
-                }
-            };
-
-            if (pixel_x != 0)
-            {
-                const int count = std::min((int)(TILE_PIXEL_SIZE - pixel_x), SCREEN_WIDTH);
-                render_tile(tile_x, screen_x, pixel_x, count);
-                screen_x += count;
-                tile_x = (tile_x + 1) & 0x1F;
-            }
-
-            while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
-            {
-                render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
-                screen_x += TILE_PIXEL_SIZE;
-                tile_x = (tile_x + 1) & 0x1F;
-            }
-
-            if (screen_x < SCREEN_WIDTH)
-                render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
-        }
-        else
-        {
-            auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
-            {
-                const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
-                const uint8_t tile_idx = vram0[map_off];
-                const uint16_t tile_addr = tile_data_base +
-                    (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
-
-                const uint8_t td1 = vram0[tile_addr + pixel_y * 2];
-                const uint8_t td2 = vram0[tile_addr + pixel_y * 2 + 1];
-                uint16_t td = (tile_pixel_lut[td1] | (tile_pixel_lut[td2] << 1)) >> (pstart * 2);
-
-                for (int i = 0; i < count; i++, td >>= 2)
-                {
-                    const uint8_t ci = td & 3;
-                    row[sx + i] = dmg_palette[(current_bgp >> (ci << 1)) & 3];
-                    scanline_priority[sx + i] = ci;
-                }
-            };
+        memcpy(state.scanline_bgp, this->scanline_bgp, SCREEN_WIDTH);
+    }
 
-            if (pixel_x != 0)
-            {
-                const int count = std::min((int)(TILE_PIXEL_SIZE - pixel_x), SCREEN_WIDTH);
-                render_tile(tile_x, screen_x, pixel_x, count);
-                screen_x += count;
-                tile_x = (tile_x + 1) & 0x1F;
-            }
+    state.window_line = this->window_line;
+    state.render_window = IsWindowVisible();
+    if (state.render_window)
+        this->window_line++;
 
-            while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
-            {
-                render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
-                screen_x += TILE_PIXEL_SIZE;
-                tile_x = (tile_x + 1) & 0x1F;
-            }
+    memcpy(state.objects, this->objects, sizeof(OAMObject) * this->object_count);
+    state.object_count = this->object_count;
 
-            if (screen_x < SCREEN_WIDTH)
-                render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
-        }
+    if (this->render_worker)
+    {
+        this->render_worker->SubmitJob();
+        return;
     }
+
+    uint16_t* row = this->framebuffer + this->scanline * SCREEN_WIDTH;
+    this->renderer.Render(state, memory->VRAMPtr(false), memory->VRAMPtr(true), row);
+    this->dirty_tracker.Update(this->scanline, row);
 }
 
-void PPU::RenderWindow(uint16_t* row)
+bool PPU::IsWindowVisible() const
 {
     const uint8_t lcdc = *LCDC;
     if (!(lcdc & LCDC_WINDOW_ENABLE) || (!(lcdc & LCDC_BG_ENABLE) && !use_cgb_rendering))
-        return;
+        return false;
 
-    const uint8_t wy = *WY;
-    const uint8_t wx = *WX;
-
-    if (this->scanline < wy)
-        return;
+    if (this->scanline < *WY)
+        return false;
 
+    const uint8_t wx = *WX;
     const int start_x = wx >= WX_OFFSET ? wx - WX_OFFSET : 0;
-    if (start_x >= SCREEN_WIDTH)
-        return;
-
-    const uint16_t tile_map_base = (lcdc & LCDC_WINDOW_TILEMAP) ? 0x1C00 : 0x1800;
-    const uint16_t tile_data_base = (lcdc & LCDC_TILE_DATA) ? 0x0000 : 0x1000;
-    const bool signed_tiles = !(lcdc & LCDC_TILE_DATA);
-
-    const uint8_t* vram0 = memory->VRAMPtr(false);
-    const uint8_t* vram1 = memory->VRAMPtr(true);
-
-    const uint8_t py = this->window_line;
-    const uint8_t tile_y = py >> 3;
-    const uint8_t pixel_y = py & 7;
-
-    int screen_x = start_x;
-    uint8_t tile_x = 0;
-
-    if (use_cgb_rendering)
-    {
-        auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
-        {
-            const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
-            const uint8_t tile_idx = vram0[map_off];
-            const uint8_t tile_attr = vram1[map_off];
-
-            const bool use_bank1 = tile_attr & OBJ_BANK_MASK;
-            const bool flip_x = tile_attr & OBJ_FLIP_X_MASK;
-            const bool flip_y = tile_attr & OBJ_FLIP_Y_MASK;
-            const bool has_bg_pri = tile_attr & OBJ_PRIORITY_MASK;
-
-            const uint8_t real_py = flip_y ? (7 - pixel_y) : pixel_y;
-            const uint16_t tile_addr = tile_data_base +
-                (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
-
-            const uint8_t* vsrc = use_bank1 ? vram1 : vram0;
-            const uint8_t td1 = vsrc[tile_addr + real_py * 2];
-            const uint8_t td2 = vsrc[tile_addr + real_py * 2 + 1];
-
-            const uint16_t* lut = flip_x ? tile_pixel_lut_flipped : tile_pixel_lut;
-            const uint16_t* pal = bg_palette_cache[tile_attr & OBJ_CGB_PALETTE_MASK];
-
-            uint16_t td = (lut[td1] | (lut[td2] << 1)) >> (pstart * 2);
-            for (int i = 0; i < count; i++, td >>= 2)
-            {
-                const uint8_t ci = td & 3;
-                row[sx + i] = pal[ci];
-                scanline_priority[sx + i] = ci;
-                scanline_bg_priority[sx + i] = has_bg_pri;
-            }
-        };
-
-        while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
-        {
-            render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
-            screen_x += TILE_PIXEL_SIZE;
-            tile_x++;
-        }
-
-        if (screen_x < SCREEN_WIDTH)
-            render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
-    }
-    else
-    {
-        auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
-        {
-            const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
-            const uint8_t tile_idx = vram0[map_off];
-            const uint16_t tile_addr = tile_data_base +
-                (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
-
-            const uint8_t td1 = vram0[tile_addr + pixel_y * 2];
-            const uint8_t td2 = vram0[tile_addr + pixel_y * 2 + 1];
-            uint16_t td = (tile_pixel_lut[td1] | (tile_pixel_lut[td2] << 1)) >> (pstart * 2);
-
-            for (int i = 0; i < count; i++, td >>= 2)
-            {
-                const uint8_t ci = td & 3;
-                row[sx + i] = dmg_palette[(scanline_bgp[sx + i] >> (ci << 1)) & 3];
-                scanline_priority[sx + i] = ci;
-            }
-        };
-
-        while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
-        {
-            render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
-            screen_x += TILE_PIXEL_SIZE;
-            tile_x++;
-        }
-
-        if (screen_x < SCREEN_WIDTH)
-            render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
-    }
-
-    this->window_line++;
+    return start_x < SCREEN_WIDTH;
 }
 
 void PPU::ScanOAM()
@@ -632,94 +409,102 @@ void PPU::ScanOAM()
     }
 }
 
-void PPU::RenderObjects(uint16_t* row)
+void PPU::PresentFrame()
 {
-    const uint8_t lcdc = *LCDC;
-    if ((lcdc & LCDC_OBJ_ENABLE) == 0)
-        return;
-
-    const uint8_t object_height = (lcdc & LCDC_OBJ_SIZE) ? 16 : 8;
-    const uint8_t* vram0 = memory->VRAMPtr(false);
-    const uint8_t* vram1 = memory->VRAMPtr(true);
-    const bool bg_enable = lcdc & LCDC_BG_ENABLE;
-
-    uint16_t obp_colors[2][4];
-    if (!use_cgb_rendering)
-    {
-        const uint8_t obp0 = *OBP0;
-        const uint8_t obp1 = *OBP1;
-        for (int i = 0; i < 4; i++)
-        {
-            obp_colors[0][i] = dmg_palette[(obp0 >> (i << 1)) & 3];
-            obp_colors[1][i] = dmg_palette[(obp1 >> (i << 1)) & 3];
-        }
-    }
+    this->dirty_rows = this->dirty_tracker.TakeFrame();
+}
 
-    for (int8_t obj_idx = this->object_count - 1; obj_idx >= 0; obj_idx--)
+void PPU::SaveState(StateWriter& writer, bool include_framebuffer) const
+{
+    // lines already drawn this frame only exist in the framebuffer
+    if (include_framebuffer)
     {
-        const OAMObject& object = this->objects[obj_idx];
-        const int object_x = object.x - 8;
-        const int object_y = object.y - 16;
-
-        const int px_start = object_x < 0 ? -object_x : 0;
-        const int px_end = (object_x + TILE_PIXEL_SIZE > SCREEN_WIDTH)
-                               ? SCREEN_WIDTH - object_x
-                               : TILE_PIXEL_SIZE;
-        if (px_start >= px_end) continue;
+        if (this->render_worker)
+            this->render_worker->WaitIdle();
 
-        const bool flip_y = object.attributes & OBJ_FLIP_Y_MASK;
-        const bool flip_x = object.attributes & OBJ_FLIP_X_MASK;
-        const bool has_priority = object.attributes & OBJ_PRIORITY_MASK;
+        writer.WriteBytes(this->framebuffer, SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t));
+    }
 
-        const int object_line = this->scanline - object_y;
-        uint8_t tile_line = flip_y ? (object_height - object_line - 1) : object_line;
-        uint16_t tile_index = object.tile_index;
+    writer.Write(this->mode);
+    writer.Write(this->dots);
+    writer.Write(this->scanline);
+    writer.Write(this->window_line);
+    writer.Write(this->ready_for_draw);
+    writer.Write(this->use_cgb_rendering);
 
-        if (object_height == 16)
-        {
-            tile_index = (tile_index & 0xFE) | (tile_line >> 3);
-            tile_line = tile_line & 7;
-        }
+    writer.Write(this->bgp_event_count);
+    writer.WriteBytes(this->bgp_events, sizeof(this->bgp_events));
+    writer.WriteBytes(this->scanline_bgp, sizeof(this->scanline_bgp));
 
-        const uint8_t* vsrc =
-            (use_cgb_rendering && (object.attributes & OBJ_BANK_MASK)) ? vram1 : vram0;
+    writer.Write(this->object_count);
+    writer.WriteBytes(this->objects, sizeof(this->objects));
 
-        const uint8_t td1 = vsrc[tile_index * TILE_SIZE_BYTES + tile_line * 2];
-        const uint8_t td2 = vsrc[tile_index * TILE_SIZE_BYTES + tile_line * 2 + 1];
+    writer.WriteBytes(this->background_palettes, sizeof(this->background_palettes));
+    writer.WriteBytes(this->object_palettes, sizeof(this->object_palettes));
 
-        const uint16_t* colors = use_cgb_rendering
-                                     ? obj_palette_cache[object.attributes & OBJ_CGB_PALETTE_MASK]
-                                     : obp_colors[(object.attributes & OBJ_DMG_PALETTE_MASK) ? 1 : 0];
-
-        const uint16_t* lut = flip_x ? tile_pixel_lut_flipped : tile_pixel_lut;
-        uint16_t td = (lut[td1] | (lut[td2] << 1)) >> (px_start * 2);
+    writer.Write(this->is_hdma_active);
+    writer.Write(this->hdma_src);
+    writer.Write(this->hdma_dst);
+    writer.Write(this->hdma_bytes_left);
+}
 
-        if (use_cgb_rendering)
-        {
-            for (int px = px_start; px < px_end; px++, td >>= 2)
-            {
-                const uint8_t ci = td & 3;
-                if (ci == 0) continue;
-                const int sx = object_x + px;
-                if (bg_enable && (scanline_bg_priority[sx] || has_priority) && scanline_priority[sx] != 0)
-                    continue;
-                row[sx] = colors[ci];
-                scanline_priority[sx] = ci;
-            }
-        }
-        else
-        {
-            for (int px = px_start; px < px_end; px++, td >>= 2)
-            {
-                const uint8_t ci = td & 3;
-                if (ci == 0) continue;
+void PPU::LoadState(StateReader& reader, bool has_framebuffer)
+{
+    if (this->render_worker)
+        this->render_worker->WaitIdle();
+
+    if (has_framebuffer)
+        reader.ReadBytes(this->framebuffer, SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t));
+
+    reader.Read(this->mode);
+    reader.Read(this->dots);
+    reader.Read(this->scanline);
+    reader.Read(this->window_line);
+    reader.Read(this->ready_for_draw);
+    reader.Read(this->use_cgb_rendering);
+
+    reader.Read(this->bgp_event_count);
+    reader.ReadBytes(this->bgp_events, sizeof(this->bgp_events));
+    reader.ReadBytes(this->scanline_bgp, sizeof(this->scanline_bgp));
+
+    reader.Read(this->object_count);
+    reader.ReadBytes(this->objects, sizeof(this->objects));
+
+    reader.ReadBytes(this->background_palettes, sizeof(this->background_palettes));
+    reader.ReadBytes(this->object_palettes, sizeof(this->object_palettes));
+
+    reader.Read(this->is_hdma_active);
+    reader.Read(this->hdma_src);
+    reader.Read(this->hdma_dst);
+    reader.Read(this->hdma_bytes_left);
+
+    // a crafted state must not send rendering or hdma outside their buffers
+    this->object_count = std::min<uint8_t>(this->object_count, OAM_MAX_SPRITES);
+    this->bgp_event_count = std::min<uint8_t>(this->bgp_event_count, SCREEN_WIDTH);
+
+    this->mode = static_cast<PPUMode>(static_cast<int>(this->mode) & STAT_MODE_MASK);
+    this->scanline = std::min<uint8_t>(this->scanline, PPU_MAX_TOTAL_SCANLINE);
+    if (this->scanline >= SCREEN_HEIGHT)
+        this->mode = PPUMode::MODE_VBLANK;
+    else if (this->mode == PPUMode::MODE_VBLANK)
+        this->mode = PPUMode::MODE_OAM;
+
+    this->hdma_src &= HDMA_SRC_MASK;
+    this->hdma_dst &= HDMA_DST_MASK;
+    this->hdma_bytes_left = std::min<uint16_t>(this->hdma_bytes_left & ~(HDMA_BLOCK_SIZE - 1), HDMA_MAX_LENGTH);
+    if (this->hdma_bytes_left == 0)
+        this->is_hdma_active = false;
+
+    for (uint8_t i = 0; i < PALETTE_SIZE * PALETTE_SIZE; i += COLOR_SIZE)
+    {
+        RebuildBGPaletteCache(i);
+        RebuildOBJPaletteCache(i);
+    }
 
-                const int sx = object_x + px;
-                if (has_priority && scanline_priority[sx] != 0) continue;
+    if (has_framebuffer)
+        this->dirty_tracker.Reset(this->framebuffer);
 
-                row[sx] = colors[ci];
-                scanline_priority[sx] = ci;
-            }
-        }
-    }
+    // vram was replaced underneath the worker's copy
+    if (this->render_worker)
+        this->render_worker->SyncVRAM();
 }
@@ -1,10 +1,11 @@
 #pragma once
 #include <array>
+#include <memory>
 
 #include "../memory/memory.h"
-
-#define SCREEN_WIDTH  160
-#define SCREEN_HEIGHT 144
+#include "scanline_renderer.h"
+#include "render_worker.h"
+#include "dirty_rows.h"
 
 #define PPU_MAX_VISIBLE_SCANLINE 143
 #define PPU_MAX_TOTAL_SCANLINE 153
@@ -43,19 +44,14 @@
 #define HDMA5_TYPE_MASK 0b10000000
 #define HDMA_TRANSFER_COMPLETE 0xFF
 #define HDMA_BLOCK_SIZE 0x10
+#define HDMA_SRC_MASK 0xFFF0
+#define HDMA_DST_MASK 0x1FF0
+#define HDMA_MAX_LENGTH 0x800
+#define HDMA_VRAM_MASK 0x1FFF
 
 #define PALETTE_ADDRESS_MASK 0b00111111
 #define PALETTE_INCREMENT_MASK 0b10000000
 
-#define LCDC_BG_ENABLE 0b00000001
-#define LCDC_OBJ_ENABLE 0b00000010
-#define LCDC_OBJ_SIZE 0b00000100
-#define LCDC_BG_TILEMAP 0b00001000
-#define LCDC_TILE_DATA 0b00010000
-#define LCDC_WINDOW_ENABLE 0b00100000
-#define LCDC_WINDOW_TILEMAP 0b01000000
-#define LCDC_ENABLE 0b10000000
-
 #define STAT_LYC 0b00000100
 #define STAT_MODE_MASK 0b00000011
 #define STAT_HBLANK_INT 0b00001000
@@ -63,22 +59,9 @@
 #define STAT_OAM_INT 0b00100000
 #define STAT_LYC_INT 0b01000000
 
-#define OBJ_DMG_PALETTE_MASK 0b00010000
-#define OBJ_FLIP_X_MASK 0b00100000
-#define OBJ_FLIP_Y_MASK 0b01000000
-#define OBJ_PRIORITY_MASK 0b10000000
-#define OBJ_BANK_MASK 0b00001000
-#define OBJ_CGB_PALETTE_MASK 0b00000111
-
 #define PALETTE_SIZE 8
 #define COLOR_SIZE 2
 
-#define TILE_SIZE_BYTES 16
-#define TILE_PIXEL_SIZE 8
-#define OAM_MAX_SPRITES 10
-
-#define WX_OFFSET 7
-
 #define OAM_STRUCT_SIZE 4
 #define OAM_MAX_COUNT 40
 
@@ -91,15 +74,6 @@ enum class PPUMode
     MODE_VBLANK = 1
 };
 
-struct OAMObject
-{
-    uint8_t y;
-    uint8_t x;
-    uint8_t tile_index;
-    uint8_t attributes;
-    uint8_t oam_index;
-};
-
 struct BGPEvent
 {
     uint8_t dot;
@@ -109,12 +83,24 @@ struct BGPEvent
 class PPU
 {
 public:
+    // the framebuffer belongs to the caller and can be set later, before the first frame
     PPU(uint16_t* framebuffer, std::array<uint16_t, 4> palette);
     void Cycle(uint8_t cycles);
     void AttachMemory(Memory* mem);
+    void EnableRenderWorker();
+
+    // collects the rows that changed since the previous frame was handed out
+    void PresentFrame();
+
+    void SaveState(StateWriter& writer, bool include_framebuffer) const;
+    void LoadState(StateReader& reader, bool has_framebuffer);
 
     uint16_t* framebuffer = nullptr;
     bool ready_for_draw = false;
+    DirtyRows dirty_rows = {};
+
+    // frames that will never be shown skip drawing, everything else is still emulated
+    bool skip_rendering = false;
 
     bool use_cgb_rendering = false;
 
@@ -128,10 +114,7 @@ private:
     void CheckLYC() const;
     void RenderScanline();
     void ScanOAM();
-
-    void RenderBackground(uint16_t* row);
-    void RenderWindow(uint16_t* row);
-    void RenderObjects(uint16_t* row);
+    bool IsWindowVisible() const;
 
     void RebuildBGPaletteCache(uint8_t idx);
     void RebuildOBJPaletteCache(uint8_t idx);
@@ -143,9 +126,6 @@ private:
     uint8_t scanline = 0;
     uint8_t window_line = 0;
 
-    uint8_t scanline_priority[SCREEN_WIDTH] = {};
-    uint8_t scanline_bg_priority[SCREEN_WIDTH] = {};
-
     BGPEvent bgp_events[SCREEN_WIDTH] = {};
     uint8_t bgp_event_count = 0;
     uint8_t scanline_bgp[SCREEN_WIDTH] = {};
@@ -166,6 +146,11 @@ private:
 
     std::array<uint16_t, 4> dmg_palette = {};
 
+    ScanlineState scanline_state = {};
+    ScanlineRenderer renderer;
+    DirtyRowTracker dirty_tracker;
+    std::unique_ptr<RenderWorker> render_worker = nullptr;
+
     uint8_t* LCDC = nullptr;
     uint8_t* STAT = nullptr;
     uint8_t* SCY = nullptr;
@@ -0,0 +1,166 @@
+#include "render_worker.h"
+#include <cstring>
+
+RenderWorker::RenderWorker(uint16_t* framebuffer, std::array<uint16_t, 4> palette, Memory* mem,
+                           DirtyRowTracker* dirty_tracker)
+    : renderer(palette)
+{
+    this->memory = mem;
+    this->framebuffer = framebuffer;
+    this->dirty_tracker = dirty_tracker;
+
+    this->jobs = std::make_unique<RenderJob[]>(RENDER_JOB_QUEUE_SIZE);
+    this->vram_log = std::make_unique<uint32_t[]>(RENDER_VRAM_LOG_SIZE);
+
+    SyncVRAM();
+    mem->SetVRAMWriteObserver(this, &RenderWorker::OnVRAMWrite);
+
+    this->thread = std::thread(&RenderWorker::Run, this);
+}
+
+RenderWorker::~RenderWorker()
+{
+    this->memory->SetVRAMWriteObserver(nullptr, nullptr);
+
+    BeginJob();
+    Push(RenderJobType::JOB_STOP);
+    this->thread.join();
+}
+
+ScanlineState& RenderWorker::BeginJob()
+{
+    const uint32_t write_pos = this->job_write_pos.load(std::memory_order_relaxed);
+
+    uint32_t read_pos = this->job_read_pos.load(std::memory_order_acquire);
+    while (write_pos - read_pos >= RENDER_JOB_QUEUE_SIZE)
+    {
+        this->job_write_pos.notify_one();
+        this->job_read_pos.wait(read_pos, std::memory_order_acquire);
+        read_pos = this->job_read_pos.load(std::memory_order_acquire);
+    }
+
+    return this->jobs[write_pos & RENDER_JOB_QUEUE_MASK].state;
+}
+
+void RenderWorker::SubmitJob()
+{
+    Push(RenderJobType::JOB_RENDER);
+}
+
+void RenderWorker::Push(RenderJobType type)
+{
+    const uint32_t write_pos = this->job_write_pos.load(std::memory_order_relaxed);
+
+    RenderJob& job = this->jobs[write_pos & RENDER_JOB_QUEUE_MASK];
+    job.type = type;
+    job.vram_log_end = this->vram_write_pos;
+
+    this->job_write_pos.store(write_pos + 1, std::memory_order_release);
+    if (type != RenderJobType::JOB_RENDER || ((write_pos + 1) % RENDER_JOB_BATCH_SIZE) == 0)
+        this->job_write_pos.notify_one();
+}
+
+void RenderWorker::WaitIdle()
+{
+    const uint32_t write_pos = this->job_write_pos.load(std::memory_order_relaxed);
+
+    uint32_t read_pos = this->job_read_pos.load(std::memory_order_acquire);
+    if (read_pos != write_pos)
+        this->job_write_pos.notify_one();
+
+    while (read_pos != write_pos)
+    {
+        this->job_read_pos.wait(read_pos, std::memory_order_acquire);
+        read_pos = this->job_read_pos.load(std::memory_order_acquire);
+    }
+}
+
+void RenderWorker::SyncVRAM()
+{
+    WaitIdle();
+
+    memcpy(this->vram[0], this->memory->VRAMPtr(false), GB_VRAM_SIZE);
+    memcpy(this->vram[1], this->memory->VRAMPtr(true), GB_VRAM_SIZE);
+
+    this->vram_read_pos.store(this->vram_write_pos, std::memory_order_release);
+}
+
+void RenderWorker::Run()
+{
+    uint32_t read_pos = this->job_read_pos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        // lines arrive in bursts while a frame is emulated, stay awake between them
+        for (int i = 0; i < RENDER_WORKER_SPIN_COUNT; i++)
+        {
+            if (this->job_write_pos.load(std::memory_order_acquire) != read_pos)
+                break;
+
+            std::this_thread::yield();
+        }
+
+        this->job_write_pos.wait(read_pos, std::memory_order_acquire);
+
+        const RenderJob& job = this->jobs[read_pos & RENDER_JOB_QUEUE_MASK];
+        if (job.type == RenderJobType::JOB_STOP)
+            break;
+
+        ApplyVRAMLog(job.vram_log_end);
+
+        if (job.type == RenderJobType::JOB_RENDER)
+        {
+            uint16_t* row = this->framebuffer + job.state.scanline * SCREEN_WIDTH;
+            this->renderer.Render(job.state, this->vram[0], this->vram[1], row);
+            this->dirty_tracker->Update(job.state.scanline, row);
+        }
+
+        read_pos++;
+        this->job_read_pos.store(read_pos, std::memory_order_release);
+        this->job_read_pos.notify_one();
+    }
+}
+
+void RenderWorker::ApplyVRAMLog(uint32_t end)
+{
+    uint32_t pos = this->vram_read_pos.load(std::memory_order_relaxed);
+    if (pos == end)
+        return;
+
+    for (; pos != end; pos++)
+    {
+        const uint32_t entry = this->vram_log[pos & RENDER_VRAM_LOG_MASK];
+        const uint16_t offset = entry & (GB_VRAM_SIZE - 1);
+        const uint8_t bank = (entry >> RENDER_VRAM_LOG_BANK_SHIFT) & 1;
+        this->vram[bank][offset] = static_cast<uint8_t>(entry >> RENDER_VRAM_LOG_VALUE_SHIFT);
+    }
+
+    this->vram_read_pos.store(pos, std::memory_order_release);
+    this->vram_read_pos.notify_one();
+}
+
+void RenderWorker::LogVRAMWrite(bool bank, uint16_t offset, uint8_t value)
+{
+    // the worker only drains the log when it gets a job, so hand it a flush when full
+    uint32_t read_pos = this->vram_read_pos.load(std::memory_order_acquire);
+    if (this->vram_write_pos - read_pos >= RENDER_VRAM_LOG_SIZE) [[unlikely]]
+    {
+        BeginJob();
+        Push(RenderJobType::JOB_FLUSH);
+
+        while (this->vram_write_pos - read_pos >= RENDER_VRAM_LOG_SIZE)
+        {
+            this->vram_read_pos.wait(read_pos, std::memory_order_acquire);
+            read_pos = this->vram_read_pos.load(std::memory_order_acquire);
+        }
+    }
+
+    this->vram_log[this->vram_write_pos & RENDER_VRAM_LOG_MASK] =
+        offset | (bank << RENDER_VRAM_LOG_BANK_SHIFT) | (value << RENDER_VRAM_LOG_VALUE_SHIFT);
+    this->vram_write_pos++;
+}
+
+void RenderWorker::OnVRAMWrite(void* ctx, bool bank, uint16_t offset, uint8_t value)
+{
+    static_cast<RenderWorker*>(ctx)->LogVRAMWrite(bank, offset, value);
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "scanline_renderer.h"
+#include "dirty_rows.h"
+#include "../memory/memory.h"
+
+#define RENDER_JOB_QUEUE_SIZE 256
+#define RENDER_JOB_QUEUE_MASK (RENDER_JOB_QUEUE_SIZE - 1)
+
+// lines are handed over in batches, waking the worker per line costs more than drawing it
+#define RENDER_JOB_BATCH_SIZE 16
+#define RENDER_WORKER_SPIN_COUNT 2048
+
+#define RENDER_VRAM_LOG_SIZE 0x8000
+#define RENDER_VRAM_LOG_MASK (RENDER_VRAM_LOG_SIZE - 1)
+
+#define RENDER_VRAM_LOG_BANK_SHIFT 13
+#define RENDER_VRAM_LOG_VALUE_SHIFT 16
+
+enum class RenderJobType
+{
+    JOB_RENDER,
+    JOB_FLUSH,
+    JOB_STOP
+};
+
+struct RenderJob
+{
+    RenderJobType type;
+    uint32_t vram_log_end;
+    ScanlineState state;
+};
+
+// rasterizes scanlines on its own thread from per-line register snapshots,
+// replaying a log of vram writes into a private copy so the emulation thread
+// can keep running while lines are drawn
+class RenderWorker
+{
+public:
+    RenderWorker(uint16_t* framebuffer, std::array<uint16_t, 4> palette, Memory* mem, DirtyRowTracker* dirty_tracker);
+    ~RenderWorker();
+
+    ScanlineState& BeginJob();
+    void SubmitJob();
+
+    void WaitIdle();
+    void SyncVRAM();
+
+private:
+    void Run();
+    void Push(RenderJobType type);
+    void ApplyVRAMLog(uint32_t end);
+
+    void LogVRAMWrite(bool bank, uint16_t offset, uint8_t value);
+    static void OnVRAMWrite(void* ctx, bool bank, uint16_t offset, uint8_t value);
+
+    Memory* memory = nullptr;
+    uint16_t* framebuffer = nullptr;
+    DirtyRowTracker* dirty_tracker = nullptr;
+
+    ScanlineRenderer renderer;
+    uint8_t vram[2][GB_VRAM_SIZE] = {};
+
+    std::unique_ptr<RenderJob[]> jobs;
+    alignas(64) std::atomic<uint32_t> job_write_pos = {0};
+    alignas(64) std::atomic<uint32_t> job_read_pos = {0};
+
+    std::unique_ptr<uint32_t[]> vram_log;
+    alignas(64) std::atomic<uint32_t> vram_read_pos = {0};
+    uint32_t vram_write_pos = 0;
+
+    std::thread thread;
+};
@@ -0,0 +1,391 @@
+#include "scanline_renderer.h"
+#include <cstring>
+#include <algorithm>
+
+// spreads the 8 bits of a tile byte two bits apart, leftmost pixel in the low bits
+static constexpr std::array<uint16_t, 256> BuildTilePixelLut(bool flipped)
+{
+    std::array<uint16_t, 256> lut = {};
+    for (int b = 0; b < 256; b++)
+    {
+        uint16_t pixels = 0;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            const uint16_t v = (b >> (7 - bit)) & 1;
+            pixels |= v << ((flipped ? 7 - bit : bit) << 1);
+        }
+
+        lut[b] = pixels;
+    }
+
+    return lut;
+}
+
+static constexpr std::array<uint16_t, 256> tile_pixel_lut_table = BuildTilePixelLut(false);
+static constexpr std::array<uint16_t, 256> tile_pixel_lut_flipped_table = BuildTilePixelLut(true);
+
+static constexpr const uint16_t* tile_pixel_lut = tile_pixel_lut_table.data();
+static constexpr const uint16_t* tile_pixel_lut_flipped = tile_pixel_lut_flipped_table.data();
+
+ScanlineRenderer::ScanlineRenderer(std::array<uint16_t, 4> palette)
+{
+    this->dmg_palette = palette;
+}
+
+void ScanlineRenderer::Render(const ScanlineState& state, const uint8_t* vram0, const uint8_t* vram1, uint16_t* row)
+{
+    memset(this->scanline_priority, 0, SCREEN_WIDTH);
+    memset(this->scanline_bg_priority, 0, SCREEN_WIDTH);
+
+    RenderBackground(state, vram0, vram1, row);
+    RenderWindow(state, vram0, vram1, row);
+    RenderObjects(state, vram0, vram1, row);
+}
+
+void ScanlineRenderer::RenderBackground(const ScanlineState& state, const uint8_t* vram0, const uint8_t* vram1, uint16_t* row)
+{
+    const uint8_t lcdc = state.lcdc;
+
+    if ((lcdc & LCDC_BG_ENABLE) == 0 && !state.use_cgb_rendering)
+        return;
+
+    const uint8_t scy = state.scy;
+    const uint8_t scx = state.scx;
+
+    const uint16_t tile_map_base = (lcdc & LCDC_BG_TILEMAP) ? 0x1C00 : 0x1800;
+    const uint16_t tile_data_base = (lcdc & LCDC_TILE_DATA) ? 0x0000 : 0x1000;
+    const bool signed_tiles = !(lcdc & LCDC_TILE_DATA);
+
+    const uint8_t py = state.scanline + scy;
+    const uint8_t tile_y = py >> 3;
+    const uint8_t pixel_y = py & 7;
+
+
+    uint8_t tile_x = (scx >> 3) & 0x1F;
+    uint8_t pixel_x = scx & 7;
+    int screen_x = 0;
+
+    if (state.use_cgb_rendering)
+    {
+        auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
+        {
+            const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
+            const uint8_t tile_idx = vram0[map_off];
+            const uint8_t tile_attr = vram1[map_off];
+
+            const bool flip_x = tile_attr & OBJ_FLIP_X_MASK;
+            const bool flip_y = tile_attr & OBJ_FLIP_Y_MASK;
+            const bool has_bg_pri = tile_attr & OBJ_PRIORITY_MASK;
+            const bool use_bank1 = tile_attr & OBJ_BANK_MASK;
+
+            const uint8_t real_py = flip_y ? (7 - pixel_y) : pixel_y;
+            const uint16_t tile_addr = tile_data_base +
+                (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
+
+            const uint8_t* vsrc = use_bank1 ? vram1 : vram0;
+            const uint8_t td1 = vsrc[tile_addr + real_py * 2];
+            const uint8_t td2 = vsrc[tile_addr + real_py * 2 + 1];
+
+            const uint16_t* lut = flip_x ? tile_pixel_lut_flipped : tile_pixel_lut;
+            const uint16_t* pal = state.bg_palette_cache[tile_attr & OBJ_CGB_PALETTE_MASK];
+
+            uint16_t td = (lut[td1] | (lut[td2] << 1)) >> (pstart * 2);
+            for (int i = 0; i < count; i++, td >>= 2)
+            {
+                const uint8_t ci = td & 3;
+                row[sx + i] = pal[ci];
+                scanline_priority[sx + i] = ci;
+                scanline_bg_priority[sx + i] = has_bg_pri;
+            }
+        };
+
+        if (pixel_x != 0)
+        {
+            const int count = std::min((int)(TILE_PIXEL_SIZE - pixel_x), SCREEN_WIDTH);
+            render_tile(tile_x, screen_x, pixel_x, count);
+            screen_x += count;
+            tile_x = (tile_x + 1) & 0x1F;
+        }
+
+        while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
+        {
+            render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
+            screen_x += TILE_PIXEL_SIZE;
+            tile_x = (tile_x + 1) & 0x1F;
+        }
+
+        if (screen_x < SCREEN_WIDTH)
+            render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
+    }
+    else
+    {
+        const uint8_t current_bgp = state.bgp;
+        const bool use_bgp_snapshot = state.use_bgp_snapshot;
+
+        if (use_bgp_snapshot)
+        {
+            auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
+            {
+                const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
+                const uint8_t tile_idx = vram0[map_off];
+                const uint16_t tile_addr = tile_data_base +
+                    (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
+
+                const uint8_t td1 = vram0[tile_addr + pixel_y * 2];
+                const uint8_t td2 = vram0[tile_addr + pixel_y * 2 + 1];
+                uint16_t td = (tile_pixel_lut[td1] | (tile_pixel_lut[td2] << 1)) >> (pstart * 2);
+
+                for (int i = 0; i < count; i++, td >>= 2)
+                {
+                    const uint8_t ci = td & 3;
+                    row[sx + i] = dmg_palette[(state.scanline_bgp[sx + i] >> (ci << 1)) & 3];
+                    scanline_priority[sx + i] = ci;
+                }
+            };
+
+            if (pixel_x != 0)
+            {
+                const int count = std::min((int)(TILE_PIXEL_SIZE - pixel_x), SCREEN_WIDTH);
+                render_tile(tile_x, screen_x, pixel_x, count);
+                screen_x += count;
+                tile_x = (tile_x + 1) & 0x1F;
+            }
+
+            while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
+            {
+                render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
+                screen_x += TILE_PIXEL_SIZE;
+                tile_x = (tile_x + 1) & 0x1F;
+            }
+
+            if (screen_x < SCREEN_WIDTH)
+                render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
+        }
+        else
+        {
+            auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
+            {
+                const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
+                const uint8_t tile_idx = vram0[map_off];
+                const uint16_t tile_addr = tile_data_base +
+                    (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
+
+                const uint8_t td1 = vram0[tile_addr + pixel_y * 2];
+                const uint8_t td2 = vram0[tile_addr + pixel_y * 2 + 1];
+                uint16_t td = (tile_pixel_lut[td1] | (tile_pixel_lut[td2] << 1)) >> (pstart * 2);
+
+                for (int i = 0; i < count; i++, td >>= 2)
+                {
+                    const uint8_t ci = td & 3;
+                    row[sx + i] = dmg_palette[(current_bgp >> (ci << 1)) & 3];
+                    scanline_priority[sx + i] = ci;
+                }
+            };
+
+            if (pixel_x != 0)
+            {
+                const int count = std::min((int)(TILE_PIXEL_SIZE - pixel_x), SCREEN_WIDTH);
+                render_tile(tile_x, screen_x, pixel_x, count);
+                screen_x += count;
+                tile_x = (tile_x + 1) & 0x1F;
+            }
+
+            while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
+            {
+                render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
+                screen_x += TILE_PIXEL_SIZE;
+                tile_x = (tile_x + 1) & 0x1F;
+            }
+
+            if (screen_x < SCREEN_WIDTH)
+                render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
+        }
+    }
+}
+
+void ScanlineRenderer::RenderWindow(const ScanlineState& state, const uint8_t* vram0, const uint8_t* vram1, uint16_t* row)
+{
+    if (!state.render_window)
+        return;
+
+    const uint8_t lcdc = state.lcdc;
+    const uint8_t wx = state.wx;
+    const int start_x = wx >= WX_OFFSET ? wx - WX_OFFSET : 0;
+
+    const uint16_t tile_map_base = (lcdc & LCDC_WINDOW_TILEMAP) ? 0x1C00 : 0x1800;
+    const uint16_t tile_data_base = (lcdc & LCDC_TILE_DATA) ? 0x0000 : 0x1000;
+    const bool signed_tiles = !(lcdc & LCDC_TILE_DATA);
+
+    const uint8_t py = state.window_line;
+    const uint8_t tile_y = py >> 3;
+    const uint8_t pixel_y = py & 7;
+
+    int screen_x = start_x;
+    uint8_t tile_x = 0;
+
+    if (state.use_cgb_rendering)
+    {
+        auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
+        {
+            const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
+            const uint8_t tile_idx = vram0[map_off];
+            const uint8_t tile_attr = vram1[map_off];
+
+            const bool use_bank1 = tile_attr & OBJ_BANK_MASK;
+            const bool flip_x = tile_attr & OBJ_FLIP_X_MASK;
+            const bool flip_y = tile_attr & OBJ_FLIP_Y_MASK;
+            const bool has_bg_pri = tile_attr & OBJ_PRIORITY_MASK;
+
+            const uint8_t real_py = flip_y ? (7 - pixel_y) : pixel_y;
+            const uint16_t tile_addr = tile_data_base +
+                (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
+
+            const uint8_t* vsrc = use_bank1 ? vram1 : vram0;
+            const uint8_t td1 = vsrc[tile_addr + real_py * 2];
+            const uint8_t td2 = vsrc[tile_addr + real_py * 2 + 1];
+
+            const uint16_t* lut = flip_x ? tile_pixel_lut_flipped : tile_pixel_lut;
+            const uint16_t* pal = state.bg_palette_cache[tile_attr & OBJ_CGB_PALETTE_MASK];
+
+            uint16_t td = (lut[td1] | (lut[td2] << 1)) >> (pstart * 2);
+            for (int i = 0; i < count; i++, td >>= 2)
+            {
+                const uint8_t ci = td & 3;
+                row[sx + i] = pal[ci];
+                scanline_priority[sx + i] = ci;
+                scanline_bg_priority[sx + i] = has_bg_pri;
+            }
+        };
+
+        while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
+        {
+            render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
+            screen_x += TILE_PIXEL_SIZE;
+            tile_x++;
+        }
+
+        if (screen_x < SCREEN_WIDTH)
+            render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
+    }
+    else
+    {
+        auto render_tile = [&](uint8_t tx, int sx, int pstart, int count)
+        {
+            const uint16_t map_off = tile_map_base + (tile_y * 32) + tx;
+            const uint8_t tile_idx = vram0[map_off];
+            const uint16_t tile_addr = tile_data_base +
+                (signed_tiles ? (int16_t)(int8_t)tile_idx : (int16_t)tile_idx) * TILE_SIZE_BYTES;
+
+            const uint8_t td1 = vram0[tile_addr + pixel_y * 2];
+            const uint8_t td2 = vram0[tile_addr + pixel_y * 2 + 1];
+            uint16_t td = (tile_pixel_lut[td1] | (tile_pixel_lut[td2] << 1)) >> (pstart * 2);
+
+            for (int i = 0; i < count; i++, td >>= 2)
+            {
+                const uint8_t ci = td & 3;
+                row[sx + i] = dmg_palette[(state.scanline_bgp[sx + i] >> (ci << 1)) & 3];
+                scanline_priority[sx + i] = ci;
+            }
+        };
+
+        while (screen_x <= SCREEN_WIDTH - TILE_PIXEL_SIZE)
+        {
+            render_tile(tile_x, screen_x, 0, TILE_PIXEL_SIZE);
+            screen_x += TILE_PIXEL_SIZE;
+            tile_x++;
+        }
+
+        if (screen_x < SCREEN_WIDTH)
+            render_tile(tile_x, screen_x, 0, SCREEN_WIDTH - screen_x);
+    }
+}
+
+void ScanlineRenderer::RenderObjects(const ScanlineState& state, const uint8_t* vram0, const uint8_t* vram1, uint16_t* row)
+{
+    const uint8_t lcdc = state.lcdc;
+    if ((lcdc & LCDC_OBJ_ENABLE) == 0)
+        return;
+
+    const uint8_t object_height = (lcdc & LCDC_OBJ_SIZE) ? 16 : 8;
+    const bool bg_enable = lcdc & LCDC_BG_ENABLE;
+
+    uint16_t obp_colors[2][4];
+    if (!state.use_cgb_rendering)
+    {
+        const uint8_t obp0 = state.obp0;
+        const uint8_t obp1 = state.obp1;
+        for (int i = 0; i < 4; i++)
+        {
+            obp_colors[0][i] = dmg_palette[(obp0 >> (i << 1)) & 3];
+            obp_colors[1][i] = dmg_palette[(obp1 >> (i << 1)) & 3];
+        }
+    }
+
+    for (int8_t obj_idx = state.object_count - 1; obj_idx >= 0; obj_idx--)
+    {
+        const OAMObject& object = state.objects[obj_idx];
+        const int object_x = object.x - 8;
+        const int object_y = object.y - 16;
+
+        const int px_start = object_x < 0 ? -object_x : 0;
+        const int px_end = (object_x + TILE_PIXEL_SIZE > SCREEN_WIDTH)
+                               ? SCREEN_WIDTH - object_x
+                               : TILE_PIXEL_SIZE;
+        if (px_start >= px_end) continue;
+
+        const bool flip_y = object.attributes & OBJ_FLIP_Y_MASK;
+        const bool flip_x = object.attributes & OBJ_FLIP_X_MASK;
+        const bool has_priority = object.attributes & OBJ_PRIORITY_MASK;
+
+        const int object_line = state.scanline - object_y;
+        uint8_t tile_line = flip_y ? (object_height - object_line - 1) : object_line;
+        uint16_t tile_index = object.tile_index;
+
+        if (object_height == 16)
+        {
+            tile_index = (tile_index & 0xFE) | (tile_line >> 3);
+            tile_line = tile_line & 7;
+        }
+
+        const uint8_t* vsrc =
+            (state.use_cgb_rendering && (object.attributes & OBJ_BANK_MASK)) ? vram1 : vram0;
+
+        const uint8_t td1 = vsrc[tile_index * TILE_SIZE_BYTES + tile_line * 2];
+        const uint8_t td2 = vsrc[tile_index * TILE_SIZE_BYTES + tile_line * 2 + 1];
+
+        const uint16_t* colors = state.use_cgb_rendering
+                                     ? state.obj_palette_cache[object.attributes & OBJ_CGB_PALETTE_MASK]
+                                     : obp_colors[(object.attributes & OBJ_DMG_PALETTE_MASK) ? 1 : 0];
+
+        const uint16_t* lut = flip_x ? tile_pixel_lut_flipped : tile_pixel_lut;
+        uint16_t td = (lut[td1] | (lut[td2] << 1)) >> (px_start * 2);
+
+        if (state.use_cgb_rendering)
+        {
+            for (int px = px_start; px < px_end; px++, td >>= 2)
+            {
+                const uint8_t ci = td & 3;
+                if (ci == 0) continue;
+                const int sx = object_x + px;
+                if (bg_enable && (scanline_bg_priority[sx] || has_priority) && scanline_priority[sx] != 0)
+                    continue;
+                row[sx] = colors[ci];
+                scanline_priority[sx] = ci;
+            }
+        }
+        else
+        {
+            for (int px = px_start; px < px_end; px++, td >>= 2)
+            {
+                const uint8_t ci = td & 3;
+                if (ci == 0) continue;
+
+                const int sx = object_x + px;
+                if (has_priority && scanline_priority[sx] != 0) continue;
+
+                row[sx] = colors[ci];
+                scanline_priority[sx] = ci;
+            }
+        }
+    }
+}
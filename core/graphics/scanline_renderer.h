@@ -0,0 +1,81 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#define SCREEN_WIDTH  160
+#define SCREEN_HEIGHT 144
+
+#define LCDC_BG_ENABLE 0b00000001
+#define LCDC_OBJ_ENABLE 0b00000010
+#define LCDC_OBJ_SIZE 0b00000100
+#define LCDC_BG_TILEMAP 0b00001000
+#define LCDC_TILE_DATA 0b00010000
+#define LCDC_WINDOW_ENABLE 0b00100000
+#define LCDC_WINDOW_TILEMAP 0b01000000
+#define LCDC_ENABLE 0b10000000
+
+#define OBJ_DMG_PALETTE_MASK 0b00010000
+#define OBJ_FLIP_X_MASK 0b00100000
+#define OBJ_FLIP_Y_MASK 0b01000000
+#define OBJ_PRIORITY_MASK 0b10000000
+#define OBJ_BANK_MASK 0b00001000
+#define OBJ_CGB_PALETTE_MASK 0b00000111
+
+#define TILE_SIZE_BYTES 16
+#define TILE_PIXEL_SIZE 8
+#define OAM_MAX_SPRITES 10
+
+#define WX_OFFSET 7
+
+struct OAMObject
+{
+    uint8_t y;
+    uint8_t x;
+    uint8_t tile_index;
+    uint8_t attributes;
+    uint8_t oam_index;
+};
+
+// everything needed to rasterize one line, captured at the end of mode 3
+struct ScanlineState
+{
+    uint8_t scanline;
+    uint8_t window_line;
+    bool render_window;
+
+    uint8_t lcdc;
+    uint8_t scy;
+    uint8_t scx;
+    uint8_t wx;
+    uint8_t bgp;
+    uint8_t obp0;
+    uint8_t obp1;
+
+    bool use_cgb_rendering;
+    bool use_bgp_snapshot;
+    uint8_t scanline_bgp[SCREEN_WIDTH];
+
+    OAMObject objects[OAM_MAX_SPRITES];
+    uint8_t object_count;
+
+    uint16_t bg_palette_cache[8][4];
+    uint16_t obj_palette_cache[8][4];
+};
+
+class ScanlineRenderer
+{
+public:
+    explicit ScanlineRenderer(std::array<uint16_t, 4> palette);
+
+    void Render(const ScanlineState& state, const uint8_t* vram0, const uint8_t* vram1, uint16_t* row);
+
+private:
+    void RenderBackground(const ScanlineState& state, const uint8_t* vram0, const uint8_t* vram1, uint16_t* row);
+    void RenderWindow(const ScanlineState& state, const uint8_t* vram0, const uint8_t* vram1, uint16_t* row);
+    void RenderObjects(const ScanlineState& state, const uint8_t* vram0, const uint8_t* vram1, uint16_t* row);
+
+    uint8_t scanline_priority[SCREEN_WIDTH] = {};
+    uint8_t scanline_bg_priority[SCREEN_WIDTH] = {};
+
+    std::array<uint16_t, 4> dmg_palette = {};
+};
@@ -9,10 +9,10 @@ void Input::AttachMemory(Memory* mem)
 {
     this->memory = mem;
 
-    mem->RegisterIOHandler(IO_ADDR_JOYP, IO_ADDR_JOYP, this, &Input::ReadJOYP, &Input::WriteJOYP);
+    mem->RegisterIOHandler<&Input::ReadJOYP, &Input::WriteJOYP>(IO_ADDR_JOYP, IO_ADDR_JOYP, this);
 
     this->JOYP = mem->PtrIO(IO_ADDR_JOYP);
-    *JOYP = 0b00001111;
+    *JOYP = JOYP_INPUT_MASK;
 }
 
 void Input::PressButton(InputButton button)
@@ -99,7 +99,8 @@ void Input::WriteJOYP(uint8_t* io, uint16_t offset, uint8_t value)
 
 void Input::Update()
 {
-    uint8_t result = 0b00001111;
+    const uint8_t previous = *JOYP;
+    uint8_t result = JOYP_INPUT_MASK;
 
     if ((*JOYP & JOYP_SELECT_BUTTONS) == 0)
         result &= ~button_state;
@@ -109,4 +110,20 @@ void Input::Update()
 
     result |= *JOYP & JOYP_SELECTION_MASK;
     *JOYP = result;
+
+    // any of P10-P13 falling requests the interrupt, whether from a press or a newly selected row
+    if (previous & ~result & JOYP_INPUT_MASK)
+        this->memory->SetInterruptFlag(INTERRUPT_JOYPAD);
+}
+
+void Input::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->button_state);
+    writer.Write(this->dpad_state);
+}
+
+void Input::LoadState(StateReader& reader)
+{
+    reader.Read(this->button_state);
+    reader.Read(this->dpad_state);
 }
@@ -15,6 +15,7 @@
 #define JOYP_BIT_P11 0b00000010
 #define JOYP_BIT_P12 0b00000100
 #define JOYP_BIT_P13 0b00001000
+#define JOYP_INPUT_MASK 0b00001111
 
 #define JOYP_BIT_RIGHT JOYP_BIT_P10
 #define JOYP_BIT_LEFT JOYP_BIT_P11
@@ -51,6 +52,9 @@ public:
 
     uint8_t ReadJOYP(uint8_t* io, uint16_t offset);
 
+    void SaveState(StateWriter& writer) const;
+    void LoadState(StateReader& reader);
+
 private:
     void Update();
 
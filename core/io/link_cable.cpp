@@ -0,0 +1,100 @@
+#include "link_cable.h"
+
+#include <algorithm>
+#include <thread>
+
+LockstepLink::LockstepLink(uint32_t quantum)
+{
+    this->quantum = std::max<uint32_t>(quantum, 1);
+}
+
+void LockstepLink::Advance(Serial& serial, uint32_t cycles)
+{
+    if (!this->connected)
+        return;
+
+    this->cycles += cycles;
+    while (this->cycles >= this->quantum && this->connected)
+    {
+        this->cycles -= this->quantum;
+        Sync(serial);
+    }
+}
+
+void LockstepLink::Send(Serial& serial, uint8_t byte)
+{
+    if (!this->connected)
+    {
+        serial.CompleteTransfer(SERIAL_DISCONNECTED_BYTE);
+        return;
+    }
+
+    Post({LinkMessageType::LINK_DATA, byte});
+}
+
+// the stream from the other side is ordered, everything it sent in this quantum comes
+// before its sync. answers go out after this side's sync and land in the next quantum
+void LockstepLink::Sync(Serial& serial)
+{
+    Post({LinkMessageType::LINK_SYNC, 0});
+
+    LinkMessage message;
+    while (true)
+    {
+        if (!Receive(message))
+        {
+            this->connected = false;
+            serial.CompleteTransfer(SERIAL_DISCONNECTED_BYTE);
+            return;
+        }
+
+        if (message.type == LinkMessageType::LINK_SYNC)
+            return;
+
+        if (message.type == LinkMessageType::LINK_DATA)
+            Post({LinkMessageType::LINK_REPLY, serial.ReceiveTransfer(message.byte)});
+        else
+            serial.CompleteTransfer(message.byte);
+    }
+}
+
+LinkCable::LinkCable(uint32_t quantum)
+{
+    this->ends[0] = std::make_unique<End>(*this, 0, quantum);
+    this->ends[1] = std::make_unique<End>(*this, 1, quantum);
+}
+
+void LinkCable::Disconnect()
+{
+    this->disconnected.store(true, std::memory_order_release);
+}
+
+LinkCable::End::End(LinkCable& cable, int side, uint32_t quantum)
+    : LockstepLink(quantum), cable(cable), side(side)
+{
+}
+
+void LinkCable::End::Post(const LinkMessage& message)
+{
+    // the other side is at most a quantum behind, the channel only fills if it stopped
+    while (!this->cable.channels[this->side].Push(message))
+    {
+        if (this->cable.disconnected.load(std::memory_order_acquire))
+            return;
+
+        std::this_thread::yield();
+    }
+}
+
+bool LinkCable::End::Receive(LinkMessage& message)
+{
+    while (!this->cable.channels[1 - this->side].Pop(message))
+    {
+        if (this->cable.disconnected.load(std::memory_order_acquire))
+            return false;
+
+        std::this_thread::yield();
+    }
+
+    return true;
+}
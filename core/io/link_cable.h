@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "serial.h"
+#include "spsc_queue.h"
+
+// t-cycles between two sync points. half a byte at the normal clock, so an answer always
+// arrives before the sender has clocked out its last bit and timing stays exact
+#define LINK_DEFAULT_QUANTUM (SERIAL_BITS_PER_BYTE * SERIAL_BIT_CYCLES / 2)
+#define LINK_CHANNEL_CAPACITY 1024
+
+enum class LinkMessageType : uint8_t
+{
+    LINK_DATA,
+    LINK_REPLY,
+    LINK_SYNC
+};
+
+struct LinkMessage
+{
+    LinkMessageType type = LinkMessageType::LINK_SYNC;
+    uint8_t byte = 0;
+};
+
+// keeps two instances in step. after every quantum of emulated t-cycles a side tells the
+// other it got there and handles everything the other sent up to the same point, so both
+// see the same bytes at the same quantum no matter how the threads are scheduled. a bigger
+// quantum syncs less often and lets both sides run further apart, at the cost of answers
+// arriving up to two quanta after a byte was sent
+class LockstepLink : public SerialTransport
+{
+public:
+    explicit LockstepLink(uint32_t quantum);
+
+    void Advance(Serial& serial, uint32_t cycles) override;
+    void Send(Serial& serial, uint8_t byte) override;
+
+    uint32_t GetQuantum() const { return this->quantum; }
+    bool IsConnected() const { return this->connected; }
+
+protected:
+    virtual void Post(const LinkMessage& message) = 0;
+    // blocks until the other side sends something, false once it is gone
+    virtual bool Receive(LinkMessage& message) = 0;
+
+private:
+    void Sync(Serial& serial);
+
+    uint32_t quantum;
+    uint32_t cycles = 0;
+    bool connected = true;
+};
+
+// two ends in one process joined by a lock-free channel each way, every end is driven by
+// the thread running its instance
+class LinkCable
+{
+public:
+    explicit LinkCable(uint32_t quantum = LINK_DEFAULT_QUANTUM);
+
+    SerialTransport* GetEnd(int side) const { return this->ends[side].get(); }
+
+    // lets a side waiting on one that stopped running go on, both act unplugged from then on
+    void Disconnect();
+
+private:
+    class End : public LockstepLink
+    {
+    public:
+        End(LinkCable& cable, int side, uint32_t quantum);
+
+    protected:
+        void Post(const LinkMessage& message) override;
+        bool Receive(LinkMessage& message) override;
+
+    private:
+        LinkCable& cable;
+        int side;
+    };
+
+    SpscQueue<LinkMessage, LINK_CHANNEL_CAPACITY> channels[2];
+    std::atomic<bool> disconnected = false;
+    std::unique_ptr<End> ends[2];
+};
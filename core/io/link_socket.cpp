@@ -0,0 +1,122 @@
+#include "link_socket.h"
+
+#ifdef LINK_SOCKET_SUPPORTED
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// a message goes over the wire as its type and byte
+#define LINK_WIRE_SIZE 2
+
+// a peer going away should fail the write, not raise SIGPIPE. macos has no such flag
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static bool make_address(const std::string& path, sockaddr_un& address)
+{
+    if (path.size() >= sizeof(address.sun_path))
+        return false;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size());
+    return true;
+}
+
+SocketLink::SocketLink(int fd, uint32_t quantum)
+    : LockstepLink(quantum), fd(fd)
+{
+}
+
+SocketLink::~SocketLink()
+{
+    if (this->fd >= 0)
+        close(this->fd);
+}
+
+std::unique_ptr<SocketLink> SocketLink::Listen(const std::string& path, uint32_t quantum)
+{
+    sockaddr_un address;
+    if (!make_address(path, address))
+        return nullptr;
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+        return nullptr;
+
+    unlink(path.c_str());
+
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 1) != 0)
+    {
+        close(listener);
+        return nullptr;
+    }
+
+    const int fd = accept(listener, nullptr, nullptr);
+    close(listener);
+    unlink(path.c_str());
+
+    if (fd < 0)
+        return nullptr;
+
+    return std::unique_ptr<SocketLink>(new SocketLink(fd, quantum));
+}
+
+std::unique_ptr<SocketLink> SocketLink::Connect(const std::string& path, uint32_t quantum)
+{
+    sockaddr_un address;
+    if (!make_address(path, address))
+        return nullptr;
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return nullptr;
+
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    return std::unique_ptr<SocketLink>(new SocketLink(fd, quantum));
+}
+
+void SocketLink::Post(const LinkMessage& message)
+{
+    const uint8_t wire[LINK_WIRE_SIZE] = {static_cast<uint8_t>(message.type), message.byte};
+
+    // a failed write shows up as the next read failing
+    size_t written = 0;
+    while (written < sizeof(wire))
+    {
+        const ssize_t result = send(this->fd, wire + written, sizeof(wire) - written, MSG_NOSIGNAL);
+        if (result <= 0)
+            return;
+
+        written += result;
+    }
+}
+
+bool SocketLink::Receive(LinkMessage& message)
+{
+    uint8_t wire[LINK_WIRE_SIZE];
+
+    size_t received = 0;
+    while (received < sizeof(wire))
+    {
+        const ssize_t result = recv(this->fd, wire + received, sizeof(wire) - received, 0);
+        if (result <= 0)
+            return false;
+
+        received += result;
+    }
+
+    if (wire[0] > static_cast<uint8_t>(LinkMessageType::LINK_SYNC))
+        return false;
+
+    message = {static_cast<LinkMessageType>(wire[0]), wire[1]};
+    return true;
+}
+#endif
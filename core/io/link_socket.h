@@ -0,0 +1,30 @@
+#pragma once
+#include <memory>
+#include <string>
+
+#include "link_cable.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LINK_SOCKET_SUPPORTED
+
+// the same lockstep protocol over a unix domain socket, for two instances in different
+// processes. one side listens and waits for the other to connect
+class SocketLink : public LockstepLink
+{
+public:
+    ~SocketLink() override;
+
+    // null if the socket can't be set up
+    static std::unique_ptr<SocketLink> Listen(const std::string& path, uint32_t quantum = LINK_DEFAULT_QUANTUM);
+    static std::unique_ptr<SocketLink> Connect(const std::string& path, uint32_t quantum = LINK_DEFAULT_QUANTUM);
+
+protected:
+    void Post(const LinkMessage& message) override;
+    bool Receive(LinkMessage& message) override;
+
+private:
+    SocketLink(int fd, uint32_t quantum);
+
+    int fd = -1;
+};
+#endif
@@ -0,0 +1,134 @@
+#include "serial.h"
+
+#include "../cpu/cpu.h"
+
+void Serial::AttachMemory(Memory* mem)
+{
+    this->memory = mem;
+
+    mem->RegisterIOHandler<&Serial::SerialRead, &Serial::SerialWrite>(IO_ADDR_SB, IO_ADDR_SC, this);
+}
+
+void Serial::AttachTransport(SerialTransport* transport)
+{
+    this->transport = transport;
+
+    // a byte waiting on the old cable would never get its answer
+    if (this->transferring && !this->has_reply)
+        CompleteTransfer(SERIAL_DISCONNECTED_BYTE);
+}
+
+void Serial::Step(uint8_t cpu_cycles, uint8_t cycles)
+{
+    if (this->transport != nullptr)
+        this->transport->Advance(*this, cycles);
+
+    if (!this->transferring)
+        return;
+
+    this->transfer_cycles -= cpu_cycles;
+    if (this->transfer_cycles <= 0 && this->has_reply)
+        FinishTransfer();
+}
+
+void Serial::FinishTransfer()
+{
+    uint8_t* io = this->memory->PtrIO(0);
+
+    this->output = io[IO_ADDR_SB];
+    this->ready_for_output = true;
+
+    io[IO_ADDR_SB] = this->reply;
+    io[IO_ADDR_SC] &= ~SC_TRANSFER_ENABLE;
+
+    this->transferring = false;
+    this->transfer_cycles = 0;
+    this->has_reply = false;
+
+    this->memory->SetInterruptFlag(INTERRUPT_SERIAL);
+}
+
+uint8_t Serial::ReceiveTransfer(uint8_t byte)
+{
+    uint8_t* io = this->memory->PtrIO(0);
+
+    if ((io[IO_ADDR_SC] & (SC_TRANSFER_ENABLE | SC_CLOCK_SELECT)) != SC_TRANSFER_ENABLE)
+        return SERIAL_DISCONNECTED_BYTE;
+
+    const uint8_t sent = io[IO_ADDR_SB];
+
+    this->output = sent;
+    this->ready_for_output = true;
+
+    io[IO_ADDR_SB] = byte;
+    io[IO_ADDR_SC] &= ~SC_TRANSFER_ENABLE;
+
+    this->memory->SetInterruptFlag(INTERRUPT_SERIAL);
+    return sent;
+}
+
+void Serial::CompleteTransfer(uint8_t byte)
+{
+    // the game gave up on the transfer before the answer came
+    if (!this->transferring)
+        return;
+
+    this->reply = byte;
+    this->has_reply = true;
+
+    if (this->transfer_cycles <= 0)
+        FinishTransfer();
+}
+
+uint8_t Serial::SerialRead(uint8_t* io, uint16_t offset)
+{
+    if (offset == IO_ADDR_SC)
+        return io[offset] | (this->memory->IsCGB() ? SC_CGB_UNUSED_MASK : SC_DMG_UNUSED_MASK);
+
+    return io[offset];
+}
+
+void Serial::SerialWrite(uint8_t* io, uint16_t offset, uint8_t value)
+{
+    io[offset] = value;
+
+    if (offset != IO_ADDR_SC)
+        return;
+
+    if ((value & (SC_TRANSFER_ENABLE | SC_CLOCK_SELECT)) != (SC_TRANSFER_ENABLE | SC_CLOCK_SELECT))
+    {
+        this->transferring = false;
+        return;
+    }
+
+    const bool fast = this->memory->IsCGB() && (value & SC_CLOCK_SPEED);
+    this->transfer_cycles = SERIAL_BITS_PER_BYTE * (fast ? SERIAL_FAST_BIT_CYCLES : SERIAL_BIT_CYCLES);
+    this->transferring = true;
+
+    if (this->transport != nullptr)
+    {
+        this->has_reply = false;
+        this->transport->Send(*this, io[IO_ADDR_SB]);
+    }
+    else
+    {
+        this->has_reply = true;
+        this->reply = SERIAL_DISCONNECTED_BYTE;
+    }
+}
+
+void Serial::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->transferring);
+    writer.Write(this->transfer_cycles);
+    writer.Write(this->has_reply);
+    writer.Write(this->reply);
+}
+
+void Serial::LoadState(StateReader& reader)
+{
+    reader.Read(this->transferring);
+    reader.Read(this->transfer_cycles);
+    reader.Read(this->has_reply);
+    reader.Read(this->reply);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../memory/memory.h"
+
+#define IO_ADDR_SB 0x01
+#define IO_ADDR_SC 0x02
+
+#define SC_TRANSFER_ENABLE 0b10000000
+#define SC_CLOCK_SPEED     0b00000010
+#define SC_CLOCK_SELECT    0b00000001
+
+// unused bits read back as set
+#define SC_DMG_UNUSED_MASK 0b01111110
+#define SC_CGB_UNUSED_MASK 0b01111100
+
+// 8192 Hz, or 262144 Hz with the cgb fast clock
+#define SERIAL_BIT_CYCLES 512
+#define SERIAL_FAST_BIT_CYCLES 16
+#define SERIAL_BITS_PER_BYTE 8
+
+// nothing is plugged in, every bit shifted in is a one
+#define SERIAL_DISCONNECTED_BYTE 0xFF
+
+class Serial;
+
+// the other end of the link cable
+class SerialTransport
+{
+public:
+    virtual ~SerialTransport() = default;
+
+    // emulated time on this side moved on, the other side's bytes are handed to the serial from here
+    virtual void Advance(Serial& serial, uint32_t cycles) = 0;
+    // this side's clock started shifting byte out, the answer comes back through CompleteTransfer
+    virtual void Send(Serial& serial, uint8_t byte) = 0;
+};
+
+class Serial
+{
+public:
+    void AttachMemory(Memory* mem);
+    // null unplugs the cable
+    void AttachTransport(SerialTransport* transport);
+    bool IsLinked() const { return this->transport != nullptr; }
+
+    // the shift clock runs on cpu cycles, a link keeps step with the other side in real time
+    // which is what cycles counts in double speed
+    void Cycle(uint8_t cpu_cycles, uint8_t cycles)
+    {
+        if (this->transferring || this->transport != nullptr) [[unlikely]]
+            Step(cpu_cycles, cycles);
+    }
+
+    // the other side clocked byte over, returns what this side shifts back. only a transfer
+    // armed on the external clock takes part, otherwise the line reads high
+    uint8_t ReceiveTransfer(uint8_t byte);
+    // the other side's answer to a transfer started here, it finishes once the bits are clocked
+    void CompleteTransfer(uint8_t byte);
+
+    void SaveState(StateWriter& writer) const;
+    void LoadState(StateReader& reader);
+
+    // set once a byte has been shifted out, the byte is in output
+    bool ready_for_output = false;
+    uint8_t output = 0;
+
+private:
+    void Step(uint8_t cpu_cycles, uint8_t cycles);
+
+    uint8_t SerialRead(uint8_t* io, uint16_t offset);
+    void SerialWrite(uint8_t* io, uint16_t offset, uint8_t value);
+
+    void FinishTransfer();
+
+    Memory* memory = nullptr;
+    SerialTransport* transport = nullptr;
+
+    // a transfer on the internal clock ends once its bits are clocked and the answer is in
+    bool transferring = false;
+    int32_t transfer_cycles = 0;
+    bool has_reply = false;
+    uint8_t reply = SERIAL_DISCONNECTED_BYTE;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// fixed size ring for one producer and one consumer thread, neither side ever blocks.
+// head and tail sit on their own cache lines so the two threads don't fight over one
+template <class T, size_t Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // false when full
+    bool Push(const T& item)
+    {
+        const size_t head = this->head.load(std::memory_order_relaxed);
+        if (head - this->tail.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        this->items[head & (Capacity - 1)] = item;
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // false when empty
+    bool Pop(T& item)
+    {
+        const size_t tail = this->tail.load(std::memory_order_relaxed);
+        if (tail == this->head.load(std::memory_order_acquire))
+            return false;
+
+        item = this->items[tail & (Capacity - 1)];
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Empty() const
+    {
+        return this->tail.load(std::memory_order_acquire) == this->head.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head = 0;
+    alignas(64) std::atomic<size_t> tail = 0;
+    T items[Capacity] = {};
+};
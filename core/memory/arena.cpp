@@ -0,0 +1,17 @@
+#include "arena.h"
+
+size_t Arena::Reserve(size_t size)
+{
+    const size_t offset = this->size;
+    this->size += (size + ARENA_ALIGNMENT - 1) & ~static_cast<size_t>(ARENA_ALIGNMENT - 1);
+    return offset;
+}
+
+void Arena::Allocate()
+{
+    // zeroed like the arrays the buffers replaced, the slack lines up the first block
+    this->storage = std::make_unique<uint8_t[]>(this->size + ARENA_ALIGNMENT - 1);
+
+    const auto address = reinterpret_cast<uintptr_t>(this->storage.get());
+    this->base = this->storage.get() + ((ARENA_ALIGNMENT - address % ARENA_ALIGNMENT) % ARENA_ALIGNMENT);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+// blocks start on their own cache line
+#define ARENA_ALIGNMENT 64
+
+// a single allocation split into the buffers of one instance. every block is reserved
+// before the memory exists, so the sizes can depend on the loaded cartridge, and all of
+// it is freed together when the arena goes away
+class Arena
+{
+public:
+    // returns the offset of the block, turned into a pointer with Get once allocated
+    size_t Reserve(size_t size);
+    void Allocate();
+
+    uint8_t* Get(size_t offset) const { return this->base + offset; }
+    size_t GetSize() const { return this->size; }
+
+private:
+    std::unique_ptr<uint8_t[]> storage;
+    uint8_t* base = nullptr;
+    size_t size = 0;
+};
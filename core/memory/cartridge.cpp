@@ -1,37 +1,44 @@
 #include "cartridge.h"
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
-Cartridge::Cartridge()
+void Cartridge::LoadRom(const std::string& rom_path, bool map_rom)
 {
-    this->ram = static_cast<uint8_t*>(calloc(1, 128 * 1024));
-}
+    this->rom = RomCache::Load(rom_path, map_rom);
+    if (this->rom == nullptr)
+    {
+        fprintf(stderr, "Failed to load rom: %s\n", rom_path.c_str());
+        return;
+    }
 
-void Cartridge::LoadRom(const std::string& rom_path)
-{
-    FILE *rom = fopen(rom_path.c_str(), "rb");
+    this->rom_data = this->rom->GetData();
 
-    fseek(rom, 0, SEEK_END);
-    const size_t size = ftell(rom);
-    rewind(rom);
+    ReadHeader();
 
-    this->rom_data = static_cast<uint8_t*>(malloc(size));
+    mbc = MBC::CreateMBC(header.cartridge_type);
 
-    fread(this->rom_data, 1, size, rom);
-    fclose(rom);
+    // the image is at least as big as the header says, banks past the end wrap around
+    mbc->rom_mask = static_cast<uint32_t>(std::bit_floor(this->rom->GetSize())) - 1;
+}
 
-    ReadHeader();
+uint32_t Cartridge::GetRamBufferSize() const
+{
+    // carts without ram still get one bank to read from, like the reads always had
+    return std::max(this->GetRamSize(), static_cast<uint32_t>(GB_ROM_EXTERNAL_RAM_SIZE));
+}
 
-    const uint32_t ram_size = this->GetRamSize();
-    if (ram_size > 0)
-    {
-        this->ram = static_cast<uint8_t*>(calloc(1, ram_size));
-    }
+void Cartridge::AttachRam(uint8_t* ram)
+{
+    this->ram = ram;
 
-    mbc = MBC::CreateMBC(header.cartridge_type);
+    // every ram size is a power of two, banks past the end wrap around
+    if (this->mbc)
+        this->mbc->ram_mask = this->GetRamBufferSize() - 1;
 }
 
 void Cartridge::ReadSave(const char* path)
@@ -72,9 +79,11 @@ void Cartridge::ReadHeader()
     this->header.cartridge_type = rom_data[HEADER_MBC_ADDR];
     this->header.rom_size = rom_data[HEADER_ROM_SIZE_ADDR];
     this->header.ram_size = rom_data[HEADER_RAM_SIZE_ADDR];
+    this->header.checksum = rom_data[HEADER_CHECKSUM_ADDR] << 16 | rom_data[HEADER_GLOBAL_CHECKSUM_ADDR] << 8 |
+                            rom_data[HEADER_GLOBAL_CHECKSUM_ADDR + 1];
 }
 
-char* Cartridge::GetTitle()
+const char* Cartridge::GetTitle() const
 {
     return this->header.title;
 }
@@ -149,6 +158,16 @@ uint8_t Cartridge::GetRamBankCount() const
     }
 }
 
+uint32_t Cartridge::GetChecksum() const
+{
+    return this->header.checksum;
+}
+
+uint16_t Cartridge::GetRomBank() const
+{
+    return this->mbc->GetRomBank();
+}
+
 bool Cartridge::HasCGBSupport() const
 {
     return this->header.has_cgb_support;
@@ -175,4 +194,16 @@ void Cartridge::WriteRam(uint16_t address, uint8_t value) const
         return;
 
     this->mbc->WriteRam(ram, address, value);
-}
\ No newline at end of file
+}
+
+void Cartridge::SaveState(StateWriter& writer) const
+{
+    writer.WriteBytes(this->ram, this->GetRamSize());
+    this->mbc->SaveState(writer);
+}
+
+void Cartridge::LoadState(StateReader& reader)
+{
+    reader.ReadBytes(this->ram, this->GetRamSize());
+    this->mbc->LoadState(reader);
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <memory>
 #include "mbc/mbc.h"
+#include "rom_cache.h"
 
 #define GB_ROM_BANK_SIZE 0x4000
 #define GB_ROM_EXTERNAL_RAM_SIZE 0x2000
@@ -13,6 +14,8 @@
 #define HEADER_ROM_SIZE_ADDR 0x148
 #define HEADER_RAM_SIZE_ADDR 0x149
 #define HEADER_ROM_VERSION_ADDR 0x14C
+#define HEADER_CHECKSUM_ADDR 0x14D
+#define HEADER_GLOBAL_CHECKSUM_ADDR 0x14E
 
 #define HEADER_CGB_ENHANCED_MASK 0b10000000
 #define HEADER_CGB_ONLY_MASK 0b01000000
@@ -27,37 +30,48 @@ struct CartridgeHeader
     uint8_t rom_size;
     uint8_t ram_size;
     bool has_cgb_support;
+    uint32_t checksum;
 };
 
 class Cartridge
 {
 public:
-    Cartridge();
+    // a mapped rom is shared with every other cartridge loaded from the same file
+    void LoadRom(const std::string& rom_path, bool map_rom = false);
+
+    // the ram lives in a buffer owned by the caller, at least GetRamBufferSize bytes
+    uint32_t GetRamBufferSize() const;
+    void AttachRam(uint8_t* ram);
 
-    void LoadRom(const std::string& rom_path);
     void ReadSave(const char* path);
     void WriteSave(const char* path);
 
-    char* GetTitle();
+    const char* GetTitle() const;
     const char* GetCartridgeType() const;
     uint32_t GetRomSize() const;
     uint32_t GetRamSize() const;
     uint8_t GetRomVersion() const;
     uint16_t GetRomBankCount() const;
     uint8_t GetRamBankCount() const;
+    uint16_t GetRomBank() const;
     bool HasCGBSupport() const;
+    uint32_t GetChecksum() const;
 
     uint8_t ReadRom(uint16_t address) const;
     void WriteRom(uint16_t address, uint8_t value) const;
     uint8_t ReadRam(uint16_t address) const;
     void WriteRam(uint16_t address, uint8_t value) const;
 
+    void SaveState(StateWriter& writer) const;
+    void LoadState(StateReader& reader);
+
 private:
     void ReadHeader();
 
     CartridgeHeader header = {};
 
-    uint8_t* rom_data = nullptr;
+    std::shared_ptr<const RomImage> rom = nullptr;
+    const uint8_t* rom_data = nullptr;
     uint8_t* ram = nullptr;
 
     std::unique_ptr<MBC> mbc = nullptr;
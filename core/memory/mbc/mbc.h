@@ -4,6 +4,8 @@
 #include <set>
 #include <vector>
 
+#include "../../state/save_state.h"
+
 class MBC
 {
 public:
@@ -16,12 +18,24 @@ public:
     virtual uint8_t ReadRam(const uint8_t* ram_data, uint16_t address) = 0;
     virtual void WriteRam(uint8_t* ram_data, uint16_t address, uint8_t value) = 0;
 
+    // bank currently mapped at 0x4000-0x7FFF
+    virtual uint16_t GetRomBank() const { return 1; }
+
+    virtual void SaveState(StateWriter& writer) const {}
+    virtual void LoadState(StateReader& reader) {}
+
     bool HasBattery();
 
     static std::unique_ptr<MBC> CreateMBC(uint8_t cartridge_type);
 
     uint8_t cartridge_type;
 
+    // size of the rom image minus one, rounded down to a power of two
+    uint32_t rom_mask = 0x7FFF;
+
+    // size of the attached ram minus one, selecting a bank past the end wraps like on hardware
+    uint32_t ram_mask = 0x1FFF;
+
 private:
     std::set<uint8_t> battery_types ={
         // MBC1
@@ -7,7 +7,7 @@ uint8_t MBC1::ReadRom(const uint8_t* rom_data, uint16_t address)
         return rom_data[address];
     }
 
-    const uint32_t mapped_address = (rom_bank * 0x4000) + (address - 0x4000);
+    const uint32_t mapped_address = ((rom_bank * 0x4000) + (address - 0x4000)) & rom_mask;
     return rom_data[mapped_address];
 }
 
@@ -38,7 +38,7 @@ uint8_t MBC1::ReadRam(const uint8_t* ram_data, uint16_t address)
     if (!ram_enabled)
         return 0xFF;
 
-    uint32_t mapped_address = (ram_bank * 0x2000) + address;
+    uint32_t mapped_address = ((ram_bank * 0x2000) + address) & ram_mask;
     return ram_data[mapped_address];
 }
 
@@ -47,6 +47,22 @@ void MBC1::WriteRam(uint8_t* ram_data, uint16_t address, uint8_t value)
     if (!ram_enabled)
         return;
 
-    uint32_t mapped_address = (ram_bank * 0x2000) + address;
+    uint32_t mapped_address = ((ram_bank * 0x2000) + address) & ram_mask;
     ram_data[mapped_address] = value;
-}
\ No newline at end of file
+}
+
+void MBC1::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->rom_bank);
+    writer.Write(this->ram_bank);
+    writer.Write(this->ram_enabled);
+    writer.Write(this->use_ram_banking);
+}
+
+void MBC1::LoadState(StateReader& reader)
+{
+    reader.Read(this->rom_bank);
+    reader.Read(this->ram_bank);
+    reader.Read(this->ram_enabled);
+    reader.Read(this->use_ram_banking);
+}
@@ -7,7 +7,7 @@ uint8_t MBC3::ReadRom(const uint8_t* rom_data, uint16_t address)
         return rom_data[address];
     }
 
-    const uint32_t mapped_address = (this->rom_bank * 0x4000) + (address - 0x4000);
+    const uint32_t mapped_address = ((this->rom_bank * 0x4000) + (address - 0x4000)) & this->rom_mask;
     return rom_data[mapped_address];
 }
 
@@ -35,7 +35,7 @@ uint8_t MBC3::ReadRam(const uint8_t* ram_data, uint16_t address)
 
     if (this->ram_bank <= 0x03)
     {
-        uint32_t mapped_address = (this->ram_bank * 0x2000) + address;
+        uint32_t mapped_address = ((this->ram_bank * 0x2000) + address) & this->ram_mask;
         return ram_data[mapped_address];
     }
 
@@ -54,7 +54,21 @@ void MBC3::WriteRam(uint8_t* ram_data, uint16_t address, uint8_t value)
 
     if (this->ram_bank <= 0x03)
     {
-        const uint32_t mapped_address = (this->ram_bank * 0x2000) + address;
+        const uint32_t mapped_address = ((this->ram_bank * 0x2000) + address) & this->ram_mask;
         ram_data[mapped_address] = value;
     }
-}
\ No newline at end of file
+}
+
+void MBC3::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->rom_bank);
+    writer.Write(this->ram_bank);
+    writer.Write(this->ram_enabled);
+}
+
+void MBC3::LoadState(StateReader& reader)
+{
+    reader.Read(this->rom_bank);
+    reader.Read(this->ram_bank);
+    reader.Read(this->ram_enabled);
+}
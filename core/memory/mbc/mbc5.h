@@ -14,6 +14,10 @@ public:
     void WriteRom(uint16_t address, uint8_t value) override;
     uint8_t ReadRam(const uint8_t* ram_data, uint16_t address) override;
     void WriteRam(uint8_t* ram_data, uint16_t address, uint8_t value) override;
+    uint16_t GetRomBank() const override { return rom_bank; }
+
+    void SaveState(StateWriter& writer) const override;
+    void LoadState(StateReader& reader) override;
 
 private:
     uint16_t rom_bank = 1;
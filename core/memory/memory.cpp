@@ -9,23 +9,29 @@
 
 void Memory::RebuildPageTable()
 {
+    PROFILE_COUNT(stats, COUNTER_PAGE_TABLE_REBUILDS);
+
     for (int i = 0; i < 256; i++)
         page_table[i] = {nullptr, nullptr};
 
+    if (wram == nullptr)
+        return;
+
+    // observed vram writes have to go through the fallback path
     uint8_t* vram = use_extra_vram ? vram2 : vram1;
     for (int pg = 0x80; pg <= 0x9F; pg++)
     {
         uint8_t* base = vram + (pg - 0x80) * 256;
-        page_table[pg] = {base, base};
+        page_table[pg] = {base, vram_observer.write ? nullptr : base};
     }
 
     for (int pg = 0xC0; pg <= 0xCF; pg++)
     {
-        uint8_t* base = wram0 + (pg - 0xC0) * 256;
+        uint8_t* base = wram + (pg - 0xC0) * 256;
         page_table[pg] = {base, base};
     }
 
-    uint8_t* wramx = wram_banks[wram_bank - 1];
+    uint8_t* wramx = wram + wram_bank * GB_WRAM_SIZE;
     for (int pg = 0xD0; pg <= 0xDF; pg++)
     {
         uint8_t* base = wramx + (pg - 0xD0) * 256;
@@ -37,6 +43,26 @@ Memory::Memory()
 {
 }
 
+size_t Memory::GetBufferSize(bool cgb)
+{
+    return cgb ? GB_CGB_WRAM_BANKS * GB_WRAM_SIZE + GB_CGB_VRAM_BANKS * GB_VRAM_SIZE
+               : GB_DMG_WRAM_BANKS * GB_WRAM_SIZE + GB_DMG_VRAM_BANKS * GB_VRAM_SIZE;
+}
+
+void Memory::AttachBuffer(uint8_t* buffer, bool cgb)
+{
+    this->vram_bank_count = cgb ? GB_CGB_VRAM_BANKS : GB_DMG_VRAM_BANKS;
+    this->wram_bank_count = cgb ? GB_CGB_WRAM_BANKS : GB_DMG_WRAM_BANKS;
+
+    this->vram1 = buffer;
+    this->vram2 = cgb ? buffer + GB_VRAM_SIZE : buffer;
+    this->wram = buffer + this->vram_bank_count * GB_VRAM_SIZE;
+
+    this->use_extra_vram = false;
+    this->wram_bank = 1;
+    RebuildPageTable();
+}
+
 void Memory::AttachCPU(CPU* cpu) { this->cpu = cpu; }
 
 void Memory::AttachCartridge(Cartridge* cart)
@@ -53,6 +79,9 @@ void Memory::LoadBootRom(const std::string& boot_rom_path)
 
     this->use_boot_rom = true;
     this->uses_cgb_bootrom = (bytes_read > GB_DMG_BOOT_ROM_SIZE);
+
+    if (IsCGB())
+        this->io[IO_ADDR_KEY1] = KEY1_UNUSED_BITS;
 }
 
 void Memory::SetInterruptFlag(uint8_t flag)
@@ -62,6 +91,8 @@ void Memory::SetInterruptFlag(uint8_t flag)
 
 uint8_t Memory::FallbackRead(uint16_t address)
 {
+    PROFILE_COUNT(stats, COUNTER_FALLBACK_READS);
+
     if (address < ADDR_ROM_END) [[likely]]
     {
         if (use_boot_rom && (address < ADDR_BOOT_ROM_END || (uses_cgb_bootrom && address >= ADDR_CGB_BOOT_ROM_BEGIN &&
@@ -77,13 +108,13 @@ uint8_t Memory::FallbackRead(uint16_t address)
         return cartridge->ReadRam(address - ADDR_CARTRIDGE_RAM_BEGIN);
 
     if (address < ADDR_WRAM0_END)
-        return wram0[address - ADDR_WRAM0_BEGIN];
+        return wram[address - ADDR_WRAM0_BEGIN];
 
     if (address < ADDR_WRAM_BANK_END)
-        return wram_banks[wram_bank - 1][address - ADDR_WRAM_BANK_BEGIN];
+        return wram[wram_bank * GB_WRAM_SIZE + address - ADDR_WRAM_BANK_BEGIN];
 
     if (address < ADDR_ECHO_END)
-        return wram0[address - ADDR_ECHO_BEGIN];
+        return wram[address - ADDR_ECHO_BEGIN];
 
     if (address < ADDR_OAM_END)
         return oam[address - ADDR_OAM_BEGIN];
@@ -102,16 +133,18 @@ uint8_t Memory::FallbackRead(uint16_t address)
 
 void Memory::FallbackWrite(uint16_t address, uint8_t value)
 {
+    PROFILE_COUNT(stats, COUNTER_FALLBACK_WRITES);
+
     if (address < ADDR_ROM_END) [[likely]]
     {
+        PROFILE_COUNT(stats, COUNTER_BANK_SWITCHES);
         cartridge->WriteRom(address, value);
         return;
     }
 
     if (address < ADDR_VRAM_END)
     {
-        if (use_extra_vram) vram2[address - ADDR_VRAM_BEGIN] = value;
-        else vram1[address - ADDR_VRAM_BEGIN] = value;
+        WriteVRAM(address - ADDR_VRAM_BEGIN, value);
         return;
     }
 
@@ -123,19 +156,19 @@ void Memory::FallbackWrite(uint16_t address, uint8_t value)
 
     if (address < ADDR_WRAM0_END)
     {
-        wram0[address - ADDR_WRAM0_BEGIN] = value;
+        wram[address - ADDR_WRAM0_BEGIN] = value;
         return;
     }
 
     if (address < ADDR_WRAM_BANK_END)
     {
-        wram_banks[wram_bank - 1][address - ADDR_WRAM_BANK_BEGIN] = value;
+        wram[wram_bank * GB_WRAM_SIZE + address - ADDR_WRAM_BANK_BEGIN] = value;
         return;
     }
 
     if (address < ADDR_ECHO_END)
     {
-        wram0[address - ADDR_ECHO_BEGIN] = value;
+        wram[address - ADDR_ECHO_BEGIN] = value;
         return;
     }
 
@@ -166,7 +199,10 @@ void Memory::FallbackWrite(uint16_t address, uint8_t value)
 uint8_t Memory::ReadIO(uint16_t offset)
 {
     if (io_lut[offset].read) [[unlikely]]
+    {
+        PROFILE_COUNT(stats, COUNTER_IO_READS);
         return io_lut[offset].read(io_lut[offset].ctx, this->io, offset);
+    }
     return this->io[offset];
 }
 
@@ -174,22 +210,29 @@ void Memory::WriteIO(uint16_t offset, uint8_t value)
 {
     if (io_lut[offset].write) [[unlikely]]
     {
+        PROFILE_COUNT(stats, COUNTER_IO_WRITES);
         io_lut[offset].write(io_lut[offset].ctx, this->io, offset, value);
         return;
     }
 
     if (offset == IO_ADDR_VBK)
     {
-        this->use_extra_vram = value & VBK_ENABLE_MASK;
+        PROFILE_COUNT(stats, COUNTER_BANK_SWITCHES);
+        this->use_extra_vram = (value & VBK_ENABLE_MASK) && this->vram_bank_count > 1;
         RebuildPageTable();
     }
 
     if (offset == IO_ADDR_WBK)
     {
-        this->wram_bank = std::max(1, value & WBK_BANK_MASK);
+        PROFILE_COUNT(stats, COUNTER_BANK_SWITCHES);
+        this->wram_bank = std::clamp(value & WBK_BANK_MASK, 1, this->wram_bank_count - 1);
         RebuildPageTable();
     }
 
+    // only the switch request is writable, the current speed changes on stop
+    if (offset == IO_ADDR_KEY1 && IsCGB())
+        value = KEY1_UNUSED_BITS | (this->io[offset] & KEY1_CURRENT_SPEED) | (value & KEY1_PREPARE_SWITCH);
+
     if (offset == IO_ADDR_BOOT && value != 0)
         this->use_boot_rom = false;
 
@@ -241,12 +284,59 @@ void Memory::WriteVRAM(uint16_t offset, uint8_t value)
 {
     if (use_extra_vram) vram2[offset] = value;
     else vram1[offset] = value;
+
+    if (vram_observer.write) [[unlikely]]
+        vram_observer.write(vram_observer.ctx, use_extra_vram, offset, value);
 }
 
 uint8_t* Memory::VRAMPtr(bool use_extra_bank) { return use_extra_bank ? vram2 : vram1; }
 uint8_t* Memory::OAMPtr() { return oam; }
 
+void Memory::SetVRAMWriteObserver(void* ctx, VRAMWriteFunction func)
+{
+    this->vram_observer = {ctx, func};
+    RebuildPageTable();
+}
+
 bool Memory::IsCGB() const
 {
     return this->cartridge->HasCGBSupport() && this->uses_cgb_bootrom;
 }
+
+void Memory::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->wram_bank);
+    writer.WriteBytes(this->wram, this->wram_bank_count * GB_WRAM_SIZE);
+    writer.WriteBytes(this->oam, sizeof(this->oam));
+    writer.WriteBytes(this->hram, sizeof(this->hram));
+    writer.WriteBytes(this->io, sizeof(this->io));
+    writer.Write(this->ie);
+
+    writer.Write(this->use_extra_vram);
+    writer.WriteBytes(this->vram1, this->vram_bank_count * GB_VRAM_SIZE);
+
+    writer.Write(this->use_boot_rom);
+    writer.Write(this->uses_cgb_bootrom);
+    writer.WriteBytes(this->boot_rom, sizeof(this->boot_rom));
+}
+
+void Memory::LoadState(StateReader& reader)
+{
+    reader.Read(this->wram_bank);
+    reader.ReadBytes(this->wram, this->wram_bank_count * GB_WRAM_SIZE);
+    reader.ReadBytes(this->oam, sizeof(this->oam));
+    reader.ReadBytes(this->hram, sizeof(this->hram));
+    reader.ReadBytes(this->io, sizeof(this->io));
+    reader.Read(this->ie);
+
+    reader.Read(this->use_extra_vram);
+    reader.ReadBytes(this->vram1, this->vram_bank_count * GB_VRAM_SIZE);
+
+    reader.Read(this->use_boot_rom);
+    reader.Read(this->uses_cgb_bootrom);
+    reader.ReadBytes(this->boot_rom, sizeof(this->boot_rom));
+
+    this->wram_bank = std::clamp<uint8_t>(this->wram_bank, 1, this->wram_bank_count - 1);
+    this->use_extra_vram = this->use_extra_vram && this->vram_bank_count > 1;
+    RebuildPageTable();
+}
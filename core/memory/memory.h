@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include "cartridge.h"
+#include "../profiling/stats.h"
 
 #define GB_DMG_BOOT_ROM_SIZE 0x100
 #define GB_CGB_BOOT_ROM_SIZE 0x900
@@ -12,6 +13,12 @@
 
 #define GB_WRAM_BANK_MAX 8
 
+// banks including wram bank 0, a dmg only has the one switchable bank and no second vram bank
+#define GB_DMG_WRAM_BANKS 2
+#define GB_CGB_WRAM_BANKS GB_WRAM_BANK_MAX
+#define GB_DMG_VRAM_BANKS 1
+#define GB_CGB_VRAM_BANKS 2
+
 #define ADDR_ROM_END 0x8000
 
 #define ADDR_VRAM_BEGIN 0x8000
@@ -49,11 +56,16 @@
 #define IO_ADDR_JOYP 0x00
 #define IO_ADDR_VBK 0x4F
 #define IO_ADDR_WBK 0x70
+#define IO_ADDR_KEY1 0x4D
 #define IO_ADDR_INTERRUPT_FLAG 0x0F
 
 #define VBK_ENABLE_MASK 0b00000001
 #define WBK_BANK_MASK 0b00000111
 
+#define KEY1_PREPARE_SWITCH 0b00000001
+#define KEY1_CURRENT_SPEED 0b10000000
+#define KEY1_UNUSED_BITS 0b01111110
+
 #define OAM_BEGIN 0xFE00
 #define OAM_END 0xFE9F
 
@@ -70,6 +82,14 @@ struct IOHandler
     IOWriteFunction write = nullptr;
 };
 
+typedef void (*VRAMWriteFunction)(void* ctx, bool bank, uint16_t offset, uint8_t value);
+
+struct VRAMWriteObserver
+{
+    void* ctx = nullptr;
+    VRAMWriteFunction write = nullptr;
+};
+
 struct MemoryPageEntry
 {
     uint8_t* read = nullptr;
@@ -81,14 +101,17 @@ class Memory
 public:
     Memory();
 
+    // wram and vram are sized for the mode and live in a buffer owned by the caller,
+    // which has to be attached before anything else
+    static size_t GetBufferSize(bool cgb);
+    void AttachBuffer(uint8_t* buffer, bool cgb);
+
     void AttachCPU(CPU* cpu);
     void AttachCartridge(Cartridge* cart);
     void LoadBootRom(const std::string& boot_rom_path);
 
-    template <class T>
-    void RegisterIOHandler(uint8_t start, uint8_t end, T* obj,
-                           uint8_t (T::*read_func)(uint8_t*, uint16_t),
-                           void (T::*write_func)(uint8_t*, uint16_t, uint8_t));
+    template <auto read_func, auto write_func, class T>
+    void RegisterIOHandler(uint8_t start, uint8_t end, T* obj);
 
     void SetInterruptFlag(uint8_t flag);
 
@@ -124,57 +147,64 @@ public:
     void WriteVRAM(uint16_t offset, uint8_t value);
     uint8_t* VRAMPtr(bool use_extra_bank);
     uint8_t* OAMPtr();
+    void SetVRAMWriteObserver(void* ctx, VRAMWriteFunction func);
 
     bool IsCGB() const;
 
     void RebuildPageTable();
 
+    void SaveState(StateWriter& writer) const;
+    void LoadState(StateReader& reader);
+
     uint8_t ie = 0;
     Cartridge* cartridge = nullptr;
 
+    GameBoyStats stats = {};
+
 private:
     uint8_t FallbackRead(uint16_t address);
     void FallbackWrite(uint16_t address, uint8_t value);
 
     CPU* cpu = nullptr;
 
+    // bank 0 followed by the switchable banks
+    uint8_t* wram = nullptr;
     uint8_t wram_bank = 1;
-    uint8_t wram0[GB_WRAM_SIZE] = {};
-    uint8_t wram_banks[GB_WRAM_BANK_MAX][GB_WRAM_SIZE] = {};
+    uint8_t wram_bank_count = 0;
 
     uint8_t oam[GB_OAM_SIZE] = {};
     uint8_t hram[GB_HRAM_SIZE] = {};
     uint8_t io[GB_IO_SIZE] = {};
 
+    // with a single bank vram2 points at vram1, readers of the attribute bank stay valid
     bool use_extra_vram = false;
-    uint8_t vram1[GB_VRAM_SIZE] = {};
-    uint8_t vram2[GB_VRAM_SIZE] = {};
+    uint8_t vram_bank_count = 0;
+    uint8_t* vram1 = nullptr;
+    uint8_t* vram2 = nullptr;
 
     bool use_boot_rom = false;
     bool uses_cgb_bootrom = false;
     uint8_t boot_rom[GB_CGB_BOOT_ROM_SIZE] = {};
 
     IOHandler io_lut[GB_IO_SIZE] = {};
+    VRAMWriteObserver vram_observer = {};
     MemoryPageEntry page_table[256] = {};
 };
 
-template <class T>
-void Memory::RegisterIOHandler(uint8_t start, uint8_t end, T* obj,
-    uint8_t (T::*read_func)(uint8_t*, uint16_t),
-    void (T::*write_func)(uint8_t*, uint16_t, uint8_t))
+// the member functions are template arguments, every registration gets its own
+// trampolines instead of sharing pointers stored per handler type
+template <auto read_func, auto write_func, class T>
+void Memory::RegisterIOHandler(uint8_t start, uint8_t end, T* obj)
 {
-    static uint8_t (T::*inst_read)(uint8_t*, uint16_t) = read_func;
-    static void (T::*inst_write)(uint8_t*, uint16_t, uint8_t) = write_func;
-
     for (uint8_t i = start; i <= end; i++)
     {
         io_lut[i] = {
             .ctx = obj,
             .read = [](void* ctx, uint8_t* io, uint16_t off) {
-                return (static_cast<T*>(ctx)->*inst_read)(io, off);
+                return (static_cast<T*>(ctx)->*read_func)(io, off);
             },
             .write = [](void* ctx, uint8_t* io, uint16_t off, uint8_t val) {
-                (static_cast<T*>(ctx)->*inst_write)(io, off, val);
+                (static_cast<T*>(ctx)->*write_func)(io, off, val);
             }
         };
     }
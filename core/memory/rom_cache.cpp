@@ -0,0 +1,180 @@
+#include "rom_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <sys/stat.h>
+
+#include "cartridge.h"
+#include "../state/hash_log.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ROM_CACHE_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define ROM_MIN_SIZE (2 * GB_ROM_BANK_SIZE)
+#define ROM_MAX_SIZE_CODE 8
+#define ROM_PAD_VALUE 0xFF
+
+struct RomCacheEntry
+{
+    uint64_t file_hash;
+    std::weak_ptr<const RomImage> image;
+};
+
+static std::mutex cache_mutex;
+static std::unordered_map<std::string, RomCacheEntry> cache;
+
+RomImage::~RomImage()
+{
+#ifdef ROM_CACHE_HAS_MMAP
+    if (this->mapped)
+        munmap(const_cast<uint8_t*>(this->data), this->size);
+#endif
+}
+
+// what the header says the rom should hold, a header that makes no sense leaves the file as is
+static size_t GetDeclaredSize(const uint8_t* data, size_t size)
+{
+    if (size <= HEADER_ROM_SIZE_ADDR || data[HEADER_ROM_SIZE_ADDR] > ROM_MAX_SIZE_CODE)
+        return ROM_MIN_SIZE;
+
+    return static_cast<size_t>(ROM_MIN_SIZE) << data[HEADER_ROM_SIZE_ADDR];
+}
+
+static bool MapRom(const std::string& path, const uint8_t*& data, size_t& size)
+{
+#ifdef ROM_CACHE_HAS_MMAP
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat file_stat = {};
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+        mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping keeps the file referenced on its own
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    data = static_cast<const uint8_t*>(mapping);
+    size = file_stat.st_size;
+
+    // a short dump would fault past the end of the file, it gets copied and padded instead
+    if (size < std::max<size_t>(ROM_MIN_SIZE, GetDeclaredSize(data, size)))
+    {
+        munmap(mapping, size);
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+static bool ReadRom(const std::string& path, std::unique_ptr<uint8_t[]>& buffer, size_t& size)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    const long file_size = ftell(file);
+    rewind(file);
+
+    if (file_size <= 0)
+    {
+        fclose(file);
+        return false;
+    }
+
+    size = std::max<size_t>(file_size, ROM_MIN_SIZE);
+    buffer = std::make_unique_for_overwrite<uint8_t[]>(size);
+    memset(buffer.get() + file_size, ROM_PAD_VALUE, size - file_size);
+
+    const size_t bytes_read = fread(buffer.get(), 1, file_size, file);
+    fclose(file);
+
+    if (bytes_read != static_cast<size_t>(file_size))
+        return false;
+
+    // only a short dump needs the second copy
+    if (const size_t declared_size = GetDeclaredSize(buffer.get(), size); declared_size > size)
+    {
+        auto padded = std::make_unique_for_overwrite<uint8_t[]>(declared_size);
+        memcpy(padded.get(), buffer.get(), size);
+        memset(padded.get() + size, ROM_PAD_VALUE, declared_size - size);
+
+        buffer = std::move(padded);
+        size = declared_size;
+    }
+
+    return true;
+}
+
+static uint64_t HashFile(const std::string& path)
+{
+    struct stat file_stat = {};
+    if (stat(path.c_str(), &file_stat) != 0)
+        return 0;
+
+    const uint64_t identity[] = {
+        static_cast<uint64_t>(file_stat.st_size),
+        static_cast<uint64_t>(file_stat.st_mtime),
+        static_cast<uint64_t>(file_stat.st_ino),
+        static_cast<uint64_t>(file_stat.st_dev),
+    };
+
+    return FrameHashLog::Hash(identity, sizeof(identity));
+}
+
+std::shared_ptr<const RomImage> RomCache::Load(const std::string& path, bool map)
+{
+    const uint64_t file_hash = HashFile(path);
+
+    std::lock_guard lock(cache_mutex);
+
+    if (auto it = cache.find(path); it != cache.end() && it->second.file_hash == file_hash)
+    {
+        if (std::shared_ptr<const RomImage> image = it->second.image.lock())
+            return image;
+    }
+
+    auto image = std::make_shared<RomImage>();
+
+    if (map && MapRom(path, image->data, image->size))
+    {
+        image->mapped = true;
+    }
+    else if (ReadRom(path, image->buffer, image->size))
+    {
+        image->data = image->buffer.get();
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    std::erase_if(cache, [](const auto& entry) { return entry.second.image.expired(); });
+    cache[path] = {file_hash, image};
+
+    return image;
+}
+
+size_t RomCache::GetLoadedCount()
+{
+    std::lock_guard lock(cache_mutex);
+
+    return std::count_if(cache.begin(), cache.end(), [](const auto& entry) {
+        return !entry.second.image.expired();
+    });
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// contents of a rom file, either mapped read-only or read into memory. the image is
+// never smaller than the size the header declares, short dumps are padded with 0xFF,
+// so a bank mask derived from GetSize keeps every read inside it
+class RomImage
+{
+public:
+    RomImage() = default;
+    ~RomImage();
+
+    RomImage(const RomImage&) = delete;
+    RomImage& operator=(const RomImage&) = delete;
+
+    const uint8_t* GetData() const { return this->data; }
+    size_t GetSize() const { return this->size; }
+    bool IsMapped() const { return this->mapped; }
+
+private:
+    friend class RomCache;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::unique_ptr<uint8_t[]> buffer;
+};
+
+// process wide, every cartridge loaded from the same unchanged file shares one image.
+// entries are keyed by path and a hash of the file's size, modification time and inode,
+// hashing the contents would read all of a mapped rom up front
+class RomCache
+{
+public:
+    // null if the file can't be read. mapping falls back to reading where it isn't available
+    static std::shared_ptr<const RomImage> Load(const std::string& path, bool map);
+
+    // images currently alive, shared ones count once
+    static size_t GetLoadedCount();
+};
@@ -0,0 +1,118 @@
+#include "execution_profile.h"
+#include <algorithm>
+#include <cstring>
+
+#include "../cpu/instruction/instruction_set.h"
+
+ExecutionProfile::ExecutionProfile(uint16_t rom_bank_count)
+{
+    this->rom_bank_count = std::max<uint16_t>(rom_bank_count, 2);
+    this->rom_slots = this->rom_bank_count * PROFILE_BANK_SIZE;
+
+    this->pc_cycles = std::make_unique<uint64_t[]>(this->rom_slots + PROFILE_RAM_SIZE);
+    this->pc_executions = std::make_unique<uint64_t[]>(this->rom_slots + PROFILE_RAM_SIZE);
+}
+
+void ExecutionProfile::Reset()
+{
+    memset(this->opcode_counts, 0, sizeof(this->opcode_counts));
+    memset(this->prefixed_counts, 0, sizeof(this->prefixed_counts));
+
+    std::fill_n(this->pc_cycles.get(), this->rom_slots + PROFILE_RAM_SIZE, 0);
+    std::fill_n(this->pc_executions.get(), this->rom_slots + PROFILE_RAM_SIZE, 0);
+}
+
+uint64_t ExecutionProfile::OpcodeCount(uint8_t opcode, bool prefixed) const
+{
+    return prefixed ? this->prefixed_counts[opcode] : this->opcode_counts[opcode];
+}
+
+std::vector<HotSpot> ExecutionProfile::HotSpots(size_t limit) const
+{
+    std::vector<HotSpot> spots;
+
+    for (uint32_t slot = 0; slot < this->rom_slots + PROFILE_RAM_SIZE; slot++)
+    {
+        if (this->pc_cycles[slot] == 0)
+            continue;
+
+        HotSpot spot = {};
+        if (slot < this->rom_slots)
+        {
+            spot.bank = static_cast<uint16_t>(slot / PROFILE_BANK_SIZE);
+            spot.pc = static_cast<uint16_t>(slot % PROFILE_BANK_SIZE + (spot.bank ? PROFILE_BANK_SIZE : 0));
+        }
+        else
+        {
+            spot.pc = static_cast<uint16_t>(slot - this->rom_slots + PROFILE_RAM_BEGIN);
+        }
+
+        spot.cycles = this->pc_cycles[slot];
+        spot.executions = this->pc_executions[slot];
+        spots.push_back(spot);
+    }
+
+    const size_t count = std::min(limit, spots.size());
+    std::partial_sort(spots.begin(), spots.begin() + count, spots.end(), [](const HotSpot& a, const HotSpot& b)
+    {
+        return a.cycles > b.cycles;
+    });
+
+    spots.resize(count);
+    return spots;
+}
+
+void ExecutionProfile::PrintReport(FILE* file, size_t limit) const
+{
+    struct OpcodeEntry
+    {
+        uint8_t opcode;
+        bool prefixed;
+        uint64_t count;
+    };
+
+    std::vector<OpcodeEntry> opcodes;
+    uint64_t total_instructions = 0;
+
+    for (int i = 0; i < PROFILE_OPCODE_COUNT; i++)
+    {
+        if (this->opcode_counts[i])
+            opcodes.push_back({static_cast<uint8_t>(i), false, this->opcode_counts[i]});
+        if (this->prefixed_counts[i])
+            opcodes.push_back({static_cast<uint8_t>(i), true, this->prefixed_counts[i]});
+
+        total_instructions += this->opcode_counts[i] + this->prefixed_counts[i];
+    }
+
+    std::sort(opcodes.begin(), opcodes.end(), [](const OpcodeEntry& a, const OpcodeEntry& b)
+    {
+        return a.count > b.count;
+    });
+
+    const double total = static_cast<double>(std::max<uint64_t>(total_instructions, 1));
+
+    fprintf(file, "hottest opcodes (%llu instructions)\n", static_cast<unsigned long long>(total_instructions));
+    for (size_t i = 0; i < std::min(limit, opcodes.size()); i++)
+    {
+        const OpcodeEntry& entry = opcodes[i];
+        const InstructionDef* def = entry.prefixed ? InstructionSet::GetPrefixed(entry.opcode) : InstructionSet::Get(entry.opcode);
+
+        fprintf(file, "  %s%02X %-16s %14llu %6.2f%%\n", entry.prefixed ? "CB " : "   ", entry.opcode,
+                def && def->name ? def->name : "?", static_cast<unsigned long long>(entry.count),
+                100.0 * entry.count / total);
+    }
+
+    const std::vector<HotSpot> spots = HotSpots(limit);
+
+    uint64_t total_cycles = 0;
+    for (uint32_t slot = 0; slot < this->rom_slots + PROFILE_RAM_SIZE; slot++)
+        total_cycles += this->pc_cycles[slot];
+
+    fprintf(file, "hottest addresses (%llu m-cycles)\n", static_cast<unsigned long long>(total_cycles));
+    for (const HotSpot& spot : spots)
+    {
+        fprintf(file, "  %03X:%04X %14llu cycles %6.2f%% %14llu executions\n", spot.bank, spot.pc,
+                static_cast<unsigned long long>(spot.cycles), 100.0 * spot.cycles / std::max<uint64_t>(total_cycles, 1),
+                static_cast<unsigned long long>(spot.executions));
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#define PROFILE_OPCODE_COUNT 0x100
+#define PROFILE_BANK_SIZE 0x4000
+#define PROFILE_RAM_BEGIN 0x8000
+#define PROFILE_RAM_SIZE 0x8000
+#define PROFILE_REPORT_DEFAULT_LIMIT 32
+
+// bank is the rom bank for code in 0x0000-0x7FFF, code running from ram reports bank 0
+struct HotSpot
+{
+    uint16_t bank;
+    uint16_t pc;
+    uint64_t cycles;
+    uint64_t executions;
+};
+
+// opcode and (bank, pc) histograms kept in flat arrays indexed directly by
+// opcode and rom offset, so recording stays cheap enough for real time play
+class ExecutionProfile
+{
+public:
+    explicit ExecutionProfile(uint16_t rom_bank_count);
+
+    void Record(uint16_t pc, uint16_t rom_bank, uint8_t opcode, bool prefixed, uint8_t mcycles)
+    {
+        (prefixed ? prefixed_counts : opcode_counts)[opcode]++;
+
+        const uint32_t slot = Slot(pc, rom_bank);
+        pc_cycles[slot] += mcycles;
+        pc_executions[slot]++;
+    }
+
+    void Reset();
+
+    uint64_t OpcodeCount(uint8_t opcode, bool prefixed) const;
+    std::vector<HotSpot> HotSpots(size_t limit) const;
+
+    void PrintReport(FILE* file, size_t limit = PROFILE_REPORT_DEFAULT_LIMIT) const;
+
+private:
+    uint32_t Slot(uint16_t pc, uint16_t rom_bank) const
+    {
+        if (pc >= PROFILE_RAM_BEGIN)
+            return rom_slots + (pc - PROFILE_RAM_BEGIN);
+
+        const uint32_t bank = pc < PROFILE_BANK_SIZE ? 0 : rom_bank % rom_bank_count;
+        return bank * PROFILE_BANK_SIZE + (pc & (PROFILE_BANK_SIZE - 1));
+    }
+
+    uint16_t rom_bank_count;
+    uint32_t rom_slots;
+
+    uint64_t opcode_counts[PROFILE_OPCODE_COUNT] = {};
+    uint64_t prefixed_counts[PROFILE_OPCODE_COUNT] = {};
+
+    std::unique_ptr<uint64_t[]> pc_cycles;
+    std::unique_ptr<uint64_t[]> pc_executions;
+};
@@ -0,0 +1,117 @@
+#include "latency.h"
+#include <algorithm>
+
+void LatencyHistogram::Add(int64_t ns)
+{
+    ns = std::max<int64_t>(ns, 0);
+
+    this->buckets[std::min<int64_t>(ns / LATENCY_BUCKET_NS, LATENCY_BUCKET_COUNT - 1)]++;
+    this->count++;
+    this->total_ns += ns;
+    this->min_ns = std::min(this->min_ns, ns);
+    this->max_ns = std::max(this->max_ns, ns);
+}
+
+double LatencyHistogram::MeanMs() const
+{
+    return this->count > 0 ? this->total_ns / 1e6 / this->count : 0.0;
+}
+
+double LatencyHistogram::PercentileMs(double percentile) const
+{
+    if (this->count == 0)
+        return 0.0;
+
+    const auto target = static_cast<uint64_t>(percentile / 100.0 * (this->count - 1)) + 1;
+    uint64_t seen = 0;
+
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++)
+    {
+        seen += this->buckets[i];
+        if (seen >= target)
+            return std::min<double>((i + 1) * static_cast<double>(LATENCY_BUCKET_NS), this->max_ns) / 1e6;
+    }
+
+    return this->max_ns / 1e6;
+}
+
+void LatencyMonitor::InputApplied(int64_t host_ns, int64_t now_ns)
+{
+    this->histograms[LATENCY_APPLIED].Add(now_ns - host_ns);
+
+    // a press while another one waits would take its answer
+    if (this->probe_ns != 0)
+        return;
+
+    this->probe_ns = host_ns;
+    this->probe_frames = 0;
+}
+
+void LatencyMonitor::FrameDrawn(bool changed, int64_t now_ns)
+{
+    if (this->probe_ns == 0)
+        return;
+
+    if (!changed)
+    {
+        if (++this->probe_frames >= LATENCY_PROBE_TIMEOUT_FRAMES)
+        {
+            this->timeouts++;
+            this->probe_ns = 0;
+        }
+
+        return;
+    }
+
+    this->histograms[LATENCY_DRAWN].Add(now_ns - this->probe_ns);
+    this->present_ns.store(this->probe_ns, std::memory_order_release);
+    this->probe_ns = 0;
+}
+
+void LatencyMonitor::FramePresented(int64_t now_ns)
+{
+    const int64_t host_ns = this->present_ns.exchange(0, std::memory_order_acquire);
+    if (host_ns != 0)
+        this->histograms[LATENCY_PRESENTED].Add(now_ns - host_ns);
+}
+
+void LatencyMonitor::Clear()
+{
+    for (LatencyHistogram& histogram : this->histograms)
+        histogram = {};
+
+    this->timeouts = 0;
+    this->probe_ns = 0;
+    this->probe_frames = 0;
+    this->present_ns.store(0, std::memory_order_relaxed);
+}
+
+void LatencyMonitor::Print(FILE* file) const
+{
+    fprintf(file, "input latency over %llu presses, %llu without an answer on screen\n",
+            static_cast<unsigned long long>(this->histograms[LATENCY_APPLIED].count),
+            static_cast<unsigned long long>(this->timeouts));
+    fprintf(file, "  %-10s %8s %8s %8s %8s %8s %8s %8s\n", "stage", "count", "mean ms", "min ms", "p50 ms", "p95 ms",
+            "p99 ms", "max ms");
+
+    for (int i = 0; i < LATENCY_STAGE_COUNT; i++)
+    {
+        const LatencyHistogram& histogram = this->histograms[i];
+
+        fprintf(file, "  %-10s %8llu %8.2f %8.2f %8.2f %8.2f %8.2f %8.2f\n", StageName(static_cast<LatencyStage>(i)),
+                static_cast<unsigned long long>(histogram.count), histogram.MeanMs(),
+                histogram.count > 0 ? histogram.min_ns / 1e6 : 0.0, histogram.PercentileMs(50.0),
+                histogram.PercentileMs(95.0), histogram.PercentileMs(99.0), histogram.max_ns / 1e6);
+    }
+}
+
+const char* LatencyMonitor::StageName(LatencyStage stage)
+{
+    switch (stage)
+    {
+    case LATENCY_APPLIED: return "applied";
+    case LATENCY_DRAWN: return "drawn";
+    case LATENCY_PRESENTED: return "presented";
+    default: return "?";
+    }
+}
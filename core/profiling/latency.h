@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// half millisecond buckets, the last one also holds everything slower
+#define LATENCY_BUCKET_NS 500000
+#define LATENCY_BUCKET_COUNT 256
+// a press nothing on screen answered within this many drawn frames is given up on
+#define LATENCY_PROBE_TIMEOUT_FRAMES 60
+
+enum LatencyStage
+{
+    LATENCY_APPLIED,
+    LATENCY_DRAWN,
+    LATENCY_PRESENTED,
+    LATENCY_STAGE_COUNT
+};
+
+struct LatencyHistogram
+{
+    uint64_t buckets[LATENCY_BUCKET_COUNT] = {};
+    uint64_t count = 0;
+    int64_t total_ns = 0;
+    int64_t min_ns = INT64_MAX;
+    int64_t max_ns = 0;
+
+    void Add(int64_t ns);
+
+    double MeanMs() const;
+    // upper edge of the bucket the percentile falls in
+    double PercentileMs(double percentile) const;
+};
+
+// follows one host button press at a time from its timestamp to the instruction it lands
+// before, to the first drawn frame with a changed row and to the frontend reporting that
+// frame on screen. any change counts as the answer, so it is measured best on a screen that
+// holds still until the game reacts, like a menu
+class LatencyMonitor
+{
+public:
+    void InputApplied(int64_t host_ns, int64_t now_ns);
+    void FrameDrawn(bool changed, int64_t now_ns);
+    // may be called from another thread than the two above
+    void FramePresented(int64_t now_ns);
+
+    void Clear();
+
+    const LatencyHistogram& GetHistogram(LatencyStage stage) const { return this->histograms[stage]; }
+    uint64_t GetTimeouts() const { return this->timeouts; }
+
+    void Print(FILE* file) const;
+
+    static const char* StageName(LatencyStage stage);
+
+private:
+    LatencyHistogram histograms[LATENCY_STAGE_COUNT];
+    uint64_t timeouts = 0;
+
+    // host time of the press waiting for the screen to change, zero when none is
+    int64_t probe_ns = 0;
+    int probe_frames = 0;
+
+    // handed from the thread drawing to the one presenting, zero when nothing waits
+    std::atomic<int64_t> present_ns = 0;
+};
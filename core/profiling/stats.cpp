@@ -0,0 +1,121 @@
+#include "stats.h"
+#include <algorithm>
+
+static int64_t stats_now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void GameBoyStats::Reset()
+{
+    *this = {};
+    this->start_ticks = ProfileNow();
+    this->start_ns = stats_now_ns();
+}
+
+double GameBoyStats::TimerNs(StatTimer timer) const
+{
+    // calibrate against the wall clock over the whole measured span
+    const double elapsed_ticks = static_cast<double>(ProfileNow() - this->start_ticks);
+    const double elapsed_ns = static_cast<double>(stats_now_ns() - this->start_ns);
+    const double ns_per_tick = elapsed_ticks > 0 && elapsed_ns > 0 ? elapsed_ns / elapsed_ticks : 1.0;
+
+    return this->timer_ticks[timer] * ns_per_tick;
+}
+
+GameBoyStats GameBoyStats::Since(const GameBoyStats& earlier) const
+{
+    GameBoyStats delta = *this;
+    delta.frames -= earlier.frames;
+
+    for (int i = 0; i < TIMER_COUNT; i++)
+    {
+        delta.timer_ticks[i] -= earlier.timer_ticks[i];
+        delta.timer_calls[i] -= earlier.timer_calls[i];
+    }
+
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        delta.counters[i] -= earlier.counters[i];
+
+    return delta;
+}
+
+void GameBoyStats::Print(FILE* file) const
+{
+    if (!ENABLED)
+    {
+        fprintf(file, "stats: not compiled in, configure with -DPESTO_GB_PROFILE=ON\n");
+        return;
+    }
+
+    const double frames = static_cast<double>(std::max<uint64_t>(this->frames, 1));
+    const double frame_ns = std::max(TimerNs(TIMER_FRAME), 1.0);
+
+    fprintf(file, "stats over %llu frames\n", static_cast<unsigned long long>(this->frames));
+    fprintf(file, "  %-16s %12s %12s %7s %14s\n", "timer", "total ms", "us/frame", "share", "calls");
+
+    for (int i = 0; i < TIMER_COUNT; i++)
+    {
+        const auto timer = static_cast<StatTimer>(i);
+        const double ns = TimerNs(timer);
+
+        fprintf(file, "  %-16s %12.3f %12.3f %6.1f%% %14llu\n", TimerName(timer), ns / 1e6, ns / 1e3 / frames,
+                100.0 * ns / frame_ns, static_cast<unsigned long long>(this->timer_calls[i]));
+    }
+
+    fprintf(file, "  %-16s %12s %12s\n", "counter", "total", "per frame");
+
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        fprintf(file, "  %-16s %12llu %12.1f\n", CounterName(static_cast<StatCounter>(i)),
+                static_cast<unsigned long long>(this->counters[i]), this->counters[i] / frames);
+    }
+}
+
+void GameBoyStats::PrintFrame(FILE* file) const
+{
+    if (!ENABLED)
+        return;
+
+    for (int i = 0; i < TIMER_COUNT; i++)
+        fprintf(file, "%s%s=%.1fus", i ? " " : "", TimerName(static_cast<StatTimer>(i)), TimerNs(static_cast<StatTimer>(i)) / 1e3);
+
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        fprintf(file, " %s=%llu", CounterName(static_cast<StatCounter>(i)), static_cast<unsigned long long>(this->counters[i]));
+
+    fprintf(file, "\n");
+}
+
+const char* GameBoyStats::TimerName(StatTimer timer)
+{
+    switch (timer)
+    {
+    case TIMER_FRAME: return "frame";
+    case TIMER_CPU: return "cpu";
+    case TIMER_PPU: return "ppu";
+    case TIMER_PPU_RENDER: return "ppu.render";
+    case TIMER_APU: return "apu";
+    case TIMER_APU_MIX: return "apu.mix";
+    case TIMER_TIMER: return "timer";
+    case TIMER_DRAW_CALLBACK: return "draw_callback";
+    case TIMER_AUDIO_CALLBACK: return "audio_callback";
+    default: return "?";
+    }
+}
+
+const char* GameBoyStats::CounterName(StatCounter counter)
+{
+    switch (counter)
+    {
+    case COUNTER_INSTRUCTIONS: return "instructions";
+    case COUNTER_SCANLINES: return "scanlines";
+    case COUNTER_SAMPLES: return "samples";
+    case COUNTER_FALLBACK_READS: return "fallback_reads";
+    case COUNTER_FALLBACK_WRITES: return "fallback_writes";
+    case COUNTER_IO_READS: return "io_reads";
+    case COUNTER_IO_WRITES: return "io_writes";
+    case COUNTER_PAGE_TABLE_REBUILDS: return "page_rebuilds";
+    case COUNTER_BANK_SWITCHES: return "bank_switches";
+    default: return "?";
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+enum StatTimer
+{
+    TIMER_FRAME,
+    TIMER_CPU,
+    TIMER_PPU,
+    TIMER_PPU_RENDER,
+    TIMER_APU,
+    TIMER_APU_MIX,
+    TIMER_TIMER,
+    TIMER_DRAW_CALLBACK,
+    TIMER_AUDIO_CALLBACK,
+    TIMER_COUNT
+};
+
+enum StatCounter
+{
+    COUNTER_INSTRUCTIONS,
+    COUNTER_SCANLINES,
+    COUNTER_SAMPLES,
+    COUNTER_FALLBACK_READS,
+    COUNTER_FALLBACK_WRITES,
+    COUNTER_IO_READS,
+    COUNTER_IO_WRITES,
+    COUNTER_PAGE_TABLE_REBUILDS,
+    COUNTER_BANK_SWITCHES,
+    COUNTER_COUNT
+};
+
+// raw ticks of the cheapest clock available, converted to ns when reported
+inline uint64_t ProfileNow()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct GameBoyStats
+{
+#ifdef PESTO_GB_PROFILE
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    uint64_t frames = 0;
+    uint64_t timer_ticks[TIMER_COUNT] = {};
+    uint64_t timer_calls[TIMER_COUNT] = {};
+    uint64_t counters[COUNTER_COUNT] = {};
+
+    // clock reference taken at reset, used to turn ticks into nanoseconds
+    uint64_t start_ticks = 0;
+    int64_t start_ns = 0;
+
+    void Reset();
+
+    double TimerNs(StatTimer timer) const;
+    GameBoyStats Since(const GameBoyStats& earlier) const;
+
+    void Print(FILE* file) const;
+    void PrintFrame(FILE* file) const;
+
+    static const char* TimerName(StatTimer timer);
+    static const char* CounterName(StatCounter counter);
+};
+
+class ScopedStatTimer
+{
+public:
+    ScopedStatTimer(GameBoyStats& stats, StatTimer timer) : stats(stats), timer(timer), start(ProfileNow()) {}
+
+    ~ScopedStatTimer()
+    {
+        stats.timer_ticks[timer] += ProfileNow() - start;
+        stats.timer_calls[timer]++;
+    }
+
+private:
+    GameBoyStats& stats;
+    StatTimer timer;
+    uint64_t start;
+};
+
+// charges the time since the previous split to a timer, one clock read per
+// boundary when consecutive steps are timed back to back
+class StatLap
+{
+public:
+    explicit StatLap(GameBoyStats& stats) : stats(stats), last(ProfileNow()) {}
+
+    void Split(StatTimer timer)
+    {
+        const uint64_t now = ProfileNow();
+        stats.timer_ticks[timer] += now - last;
+        stats.timer_calls[timer]++;
+        last = now;
+    }
+
+private:
+    GameBoyStats& stats;
+    uint64_t last;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PESTO_GB_PROFILE
+#define PROFILE_SCOPE(stats, timer) ScopedStatTimer PROFILE_CONCAT(scoped_stat_timer_, __LINE__)((stats), (timer))
+#define PROFILE_LAP_BEGIN(stats) StatLap stat_lap((stats))
+#define PROFILE_LAP(timer) stat_lap.Split((timer))
+#define PROFILE_COUNT(stats, counter) ((stats).counters[(counter)]++)
+#define PROFILE_ADD(stats, counter, value) ((stats).counters[(counter)] += (value))
+#else
+#define PROFILE_SCOPE(stats, timer) ((void)0)
+#define PROFILE_LAP_BEGIN(stats) ((void)0)
+#define PROFILE_LAP(timer) ((void)0)
+#define PROFILE_COUNT(stats, counter) ((void)0)
+#define PROFILE_ADD(stats, counter, value) ((void)0)
+#endif
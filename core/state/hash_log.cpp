@@ -0,0 +1,58 @@
+#include "hash_log.h"
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+void FrameHashLog::AddSample(AudioSample left, AudioSample right)
+{
+    const AudioSample samples[2] = { left, right };
+    this->audio_hash = Hash(samples, sizeof(samples), this->audio_hash);
+}
+
+void FrameHashLog::AddFrame(const uint16_t* framebuffer, size_t pixel_count)
+{
+    this->entries.push_back({
+        .frame = static_cast<uint32_t>(this->entries.size()),
+        .framebuffer = Hash(framebuffer, pixel_count * sizeof(uint16_t)),
+        .audio = this->audio_hash,
+    });
+
+    this->audio_hash = HASH_LOG_OFFSET;
+}
+
+void FrameHashLog::Clear()
+{
+    this->entries.clear();
+    this->audio_hash = HASH_LOG_OFFSET;
+}
+
+bool FrameHashLog::Write(const std::string& path) const
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    for (const FrameHash& entry : this->entries)
+        fprintf(file, "%u %016" PRIx64 " %016" PRIx64 "\n", entry.frame, entry.framebuffer, entry.audio);
+
+    return fclose(file) == 0;
+}
+
+uint64_t FrameHashLog::Hash(const void* data, size_t size, uint64_t hash)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    // fnv-1a over 64 bit words, the tail byte by byte
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * HASH_LOG_PRIME;
+    }
+
+    for (; i < size; i++)
+        hash = (hash ^ bytes[i]) * HASH_LOG_PRIME;
+
+    return hash;
+}
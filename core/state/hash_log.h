@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../audio/audio_sample.h"
+
+#define HASH_LOG_OFFSET 0xCBF29CE484222325
+#define HASH_LOG_PRIME 0x100000001B3
+
+struct FrameHash
+{
+    uint32_t frame;
+    uint64_t framebuffer;
+    // covers the samples produced since the previous frame
+    uint64_t audio;
+};
+
+// one framebuffer and audio hash per presented frame, diffing two logs shows the first
+// frame where a change to the core altered what is seen or heard
+class FrameHashLog
+{
+public:
+    void AddSample(AudioSample left, AudioSample right);
+    void AddFrame(const uint16_t* framebuffer, size_t pixel_count);
+
+    void Clear();
+    const std::vector<FrameHash>& GetEntries() const { return this->entries; }
+
+    // one "<frame> <framebuffer hash> <audio hash>" line per frame
+    bool Write(const std::string& path) const;
+
+    static uint64_t Hash(const void* data, size_t size, uint64_t hash = HASH_LOG_OFFSET);
+
+private:
+    std::vector<FrameHash> entries;
+    uint64_t audio_hash = HASH_LOG_OFFSET;
+};
@@ -0,0 +1,135 @@
+#include "movie.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#define MOVIE_EVENT_PRESSED 0x80
+#define MOVIE_EVENT_BUTTON_MASK 0x7F
+
+struct MovieHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t state_size;
+    uint32_t event_count;
+};
+
+void Movie::Clear()
+{
+    this->start_state.clear();
+    this->events.clear();
+}
+
+void Movie::AddEvent(uint64_t cycle, InputButton button, bool pressed)
+{
+    this->events.push_back({cycle, button, pressed});
+}
+
+void Movie::Truncate(uint64_t cycle)
+{
+    this->events.resize(Find(cycle));
+}
+
+size_t Movie::Find(uint64_t cycle) const
+{
+    const auto it = std::lower_bound(this->events.begin(), this->events.end(), cycle,
+                                     [](const MovieEvent& event, uint64_t value) { return event.cycle < value; });
+    return it - this->events.begin();
+}
+
+bool Movie::Save(const std::string& path) const
+{
+    std::vector<uint8_t> data;
+    data.reserve(this->events.size() * 4);
+
+    uint64_t last_cycle = 0;
+    for (const MovieEvent& event : this->events)
+    {
+        uint64_t delta = event.cycle - last_cycle;
+        while (delta >= 0x80)
+        {
+            data.push_back(static_cast<uint8_t>(delta | 0x80));
+            delta >>= 7;
+        }
+        data.push_back(static_cast<uint8_t>(delta));
+        data.push_back(static_cast<uint8_t>(event.button) | (event.pressed ? MOVIE_EVENT_PRESSED : 0));
+
+        last_cycle = event.cycle;
+    }
+
+    const MovieHeader header = {
+        .magic = MOVIE_MAGIC,
+        .version = MOVIE_VERSION,
+        .state_size = static_cast<uint32_t>(this->start_state.size()),
+        .event_count = static_cast<uint32_t>(this->events.size()),
+    };
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && fwrite(this->start_state.data(), 1, this->start_state.size(), file) == this->start_state.size();
+    ok = ok && fwrite(data.data(), 1, data.size(), file) == data.size();
+    fclose(file);
+
+    return ok;
+}
+
+bool Movie::Load(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    rewind(file);
+
+    std::vector<uint8_t> data(size > 0 ? size : 0);
+    const size_t bytes_read = fread(data.data(), 1, data.size(), file);
+    fclose(file);
+
+    MovieHeader header;
+    if (bytes_read != data.size() || data.size() < sizeof(header))
+        return false;
+
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != MOVIE_MAGIC || header.version != MOVIE_VERSION ||
+        header.state_size > data.size() - sizeof(header))
+    {
+        return false;
+    }
+
+    Clear();
+
+    const uint8_t* state = data.data() + sizeof(header);
+    this->start_state.assign(state, state + header.state_size);
+
+    size_t position = sizeof(header) + header.state_size;
+    uint64_t cycle = 0;
+
+    for (uint32_t i = 0; i < header.event_count; i++)
+    {
+        uint64_t delta = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            if (position >= data.size() || shift > 63)
+                return false;
+
+            const uint8_t byte = data[position++];
+            delta |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                break;
+        }
+
+        if (position >= data.size())
+            return false;
+
+        const uint8_t value = data[position++];
+        cycle += delta;
+        AddEvent(cycle, static_cast<InputButton>(value & MOVIE_EVENT_BUTTON_MASK), value & MOVIE_EVENT_PRESSED);
+    }
+
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../io/input.h"
+
+#define MOVIE_MAGIC 0x4D564750 // "PGVM"
+#define MOVIE_VERSION 1
+
+enum class MovieMode
+{
+    MOVIE_NONE,
+    MOVIE_RECORDING,
+    MOVIE_PLAYING
+};
+
+struct MovieEvent
+{
+    uint64_t cycle;
+    InputButton button;
+    bool pressed;
+};
+
+// button changes stamped with the cpu cycle they took effect on, plus the state the
+// recording started from. replaying the events from that state reproduces the run exactly
+class Movie
+{
+public:
+    void Clear();
+    void AddEvent(uint64_t cycle, InputButton button, bool pressed);
+
+    // drops everything at or after cycle, used when the machine goes back in time while recording
+    void Truncate(uint64_t cycle);
+    // index of the first event at or after cycle
+    size_t Find(uint64_t cycle) const;
+
+    // events are stored as varint cycle deltas and one byte per button change
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+
+    std::vector<uint8_t> start_state;
+    std::vector<MovieEvent> events;
+};
@@ -0,0 +1,246 @@
+#include "rewind.h"
+#include <algorithm>
+#include <cstring>
+
+static size_t WriteVarint(uint8_t* out, size_t value)
+{
+    size_t length = 0;
+    while (value >= 0x80)
+    {
+        out[length++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+
+    out[length++] = static_cast<uint8_t>(value);
+    return length;
+}
+
+static bool ReadVarint(const uint8_t* in, size_t in_size, size_t& position, size_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (position >= in_size)
+            return false;
+
+        const uint8_t byte = in[position++];
+        value |= static_cast<size_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+RewindBuffer::RewindBuffer(size_t capacity, int interval)
+{
+    this->capacity = capacity;
+    this->interval = std::max(interval, 1);
+    this->ring = std::make_unique<uint8_t[]>(capacity);
+}
+
+bool RewindBuffer::FrameDone()
+{
+    if (++this->frames_since_push < this->interval)
+        return false;
+
+    this->frames_since_push = 0;
+    return true;
+}
+
+void RewindBuffer::Push(const uint8_t* state, size_t size)
+{
+    // the size only changes if the state format does, older deltas would not line up
+    if (!this->has_newest || this->newest.size() != size)
+    {
+        Clear();
+        this->newest.assign(state, state + size);
+        this->scratch.resize(MaxEncodedSize(size));
+        this->has_newest = true;
+        return;
+    }
+
+    const size_t encoded_size = EncodeDelta(this->newest.data(), state, size, this->scratch.data());
+    const size_t entry_size = encoded_size + REWIND_ENTRY_OVERHEAD;
+
+    if (entry_size > this->capacity)
+    {
+        this->head = this->tail = 0;
+        this->entry_count = 0;
+    }
+    else
+    {
+        while (this->capacity - GetUsedBytes() < entry_size)
+            DropOldest();
+
+        const auto size32 = static_cast<uint32_t>(encoded_size);
+        RingWrite(this->head, &size32, sizeof(size32));
+        RingWrite(this->head + sizeof(size32), this->scratch.data(), encoded_size);
+        RingWrite(this->head + sizeof(size32) + encoded_size, &size32, sizeof(size32));
+
+        this->head += entry_size;
+        this->entry_count++;
+    }
+
+    memcpy(this->newest.data(), state, size);
+}
+
+bool RewindBuffer::Pop(std::vector<uint8_t>& state)
+{
+    if (!this->has_newest)
+        return false;
+
+    state.assign(this->newest.begin(), this->newest.end());
+    this->frames_since_push = 0;
+
+    if (this->entry_count == 0)
+    {
+        this->has_newest = false;
+        return true;
+    }
+
+    uint32_t encoded_size;
+    RingRead(this->head - sizeof(encoded_size), &encoded_size, sizeof(encoded_size));
+
+    const uint64_t entry_start = this->head - encoded_size - REWIND_ENTRY_OVERHEAD;
+    RingRead(entry_start + sizeof(encoded_size), this->scratch.data(), encoded_size);
+
+    this->head = entry_start;
+    this->entry_count--;
+
+    // a broken entry means the rest of the history can't be trusted either
+    if (!DecodeDelta(this->scratch.data(), encoded_size, this->newest.data(), this->newest.size()))
+        Clear();
+
+    return true;
+}
+
+void RewindBuffer::Clear()
+{
+    this->head = this->tail = 0;
+    this->entry_count = 0;
+    this->has_newest = false;
+    this->frames_since_push = 0;
+}
+
+size_t RewindBuffer::GetStateCount() const
+{
+    return this->has_newest ? this->entry_count + 1 : 0;
+}
+
+size_t RewindBuffer::GetUsedBytes() const
+{
+    return static_cast<size_t>(this->head - this->tail);
+}
+
+size_t RewindBuffer::EncodeDelta(const uint8_t* a, const uint8_t* b, size_t size, uint8_t* out)
+{
+    size_t position = 0;
+    size_t out_size = 0;
+
+    while (position < size)
+    {
+        const size_t zero_start = position;
+
+        // unchanged memory is the common case, skip it a word at a time
+        while (position + sizeof(uint64_t) <= size)
+        {
+            uint64_t word_a, word_b;
+            memcpy(&word_a, a + position, sizeof(word_a));
+            memcpy(&word_b, b + position, sizeof(word_b));
+            if (word_a != word_b)
+                break;
+
+            position += sizeof(uint64_t);
+        }
+
+        while (position < size && a[position] == b[position])
+            position++;
+
+        const size_t literal_start = position;
+        while (position < size)
+        {
+            if (a[position] != b[position])
+            {
+                position++;
+                continue;
+            }
+
+            size_t run = 1;
+            while (run < REWIND_MIN_ZERO_RUN && position + run < size && a[position + run] == b[position + run])
+                run++;
+
+            if (run >= REWIND_MIN_ZERO_RUN || position + run == size)
+                break;
+
+            position += run;
+        }
+
+        out_size += WriteVarint(out + out_size, literal_start - zero_start);
+        out_size += WriteVarint(out + out_size, position - literal_start);
+
+        for (size_t i = literal_start; i < position; i++)
+            out[out_size++] = a[i] ^ b[i];
+    }
+
+    return out_size;
+}
+
+bool RewindBuffer::DecodeDelta(const uint8_t* in, size_t in_size, uint8_t* state, size_t size)
+{
+    size_t in_position = 0;
+    size_t position = 0;
+
+    while (in_position < in_size)
+    {
+        size_t zeros, literals;
+        if (!ReadVarint(in, in_size, in_position, zeros) || !ReadVarint(in, in_size, in_position, literals))
+            return false;
+
+        position += zeros;
+        if (position + literals > size || in_position + literals > in_size)
+            return false;
+
+        for (size_t i = 0; i < literals; i++)
+            state[position + i] ^= in[in_position + i];
+
+        position += literals;
+        in_position += literals;
+    }
+
+    return position <= size;
+}
+
+size_t RewindBuffer::MaxEncodedSize(size_t size)
+{
+    // a single literal covering everything plus its two length prefixes
+    return size + 2 * 10;
+}
+
+void RewindBuffer::DropOldest()
+{
+    uint32_t encoded_size;
+    RingRead(this->tail, &encoded_size, sizeof(encoded_size));
+
+    this->tail += encoded_size + REWIND_ENTRY_OVERHEAD;
+    this->entry_count--;
+}
+
+void RewindBuffer::RingWrite(uint64_t position, const void* data, size_t size)
+{
+    const size_t offset = position % this->capacity;
+    const size_t first = std::min(size, this->capacity - offset);
+
+    memcpy(this->ring.get() + offset, data, first);
+    memcpy(this->ring.get(), static_cast<const uint8_t*>(data) + first, size - first);
+}
+
+void RewindBuffer::RingRead(uint64_t position, void* out, size_t size) const
+{
+    const size_t offset = position % this->capacity;
+    const size_t first = std::min(size, this->capacity - offset);
+
+    memcpy(out, this->ring.get() + offset, first);
+    memcpy(static_cast<uint8_t*>(out) + first, this->ring.get(), size - first);
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#define REWIND_DEFAULT_CAPACITY (16 * 1024 * 1024)
+#define REWIND_DEFAULT_INTERVAL 4
+
+// equal bytes shorter than this stay inside a literal, which bounds the coded size of
+// a delta to the state size plus a few bytes
+#define REWIND_MIN_ZERO_RUN 4
+
+// every entry is framed by its size on both ends so the ring can be walked from either side
+#define REWIND_ENTRY_OVERHEAD (2 * sizeof(uint32_t))
+
+// history of save states in a fixed-size byte ring. the newest state is kept whole,
+// every older one is stored as the xor against the state recorded after it, coded as
+// runs of unchanged bytes and literals. most of memory is untouched between two
+// snapshots so an entry is usually a few kilobytes instead of a full state
+class RewindBuffer
+{
+public:
+    RewindBuffer(size_t capacity, int interval);
+
+    // counts a finished frame, true once every interval frames when a state should be pushed
+    bool FrameDone();
+
+    void Push(const uint8_t* state, size_t size);
+
+    // hands back the newest state and drops it, the one before becomes the newest
+    bool Pop(std::vector<uint8_t>& state);
+
+    void Clear();
+
+    int GetInterval() const { return this->interval; }
+    size_t GetCapacity() const { return this->capacity; }
+    size_t GetStateCount() const;
+    size_t GetUsedBytes() const;
+
+    // writes the run coded xor of a and b to out, which needs room for MaxEncodedSize(size)
+    static size_t EncodeDelta(const uint8_t* a, const uint8_t* b, size_t size, uint8_t* out);
+    // xors a delta produced by EncodeDelta back into state
+    static bool DecodeDelta(const uint8_t* in, size_t in_size, uint8_t* state, size_t size);
+    static size_t MaxEncodedSize(size_t size);
+
+private:
+    void DropOldest();
+    void RingWrite(uint64_t position, const void* data, size_t size);
+    void RingRead(uint64_t position, void* out, size_t size) const;
+
+    std::unique_ptr<uint8_t[]> ring;
+    size_t capacity = 0;
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    size_t entry_count = 0;
+
+    std::vector<uint8_t> newest;
+    std::vector<uint8_t> scratch;
+    bool has_newest = false;
+
+    int interval = REWIND_DEFAULT_INTERVAL;
+    int frames_since_push = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#define SAVE_STATE_MAGIC 0x53534750 // "PGSS"
+#define SAVE_STATE_VERSION 9
+
+#define SAVE_STATE_FLAG_FRAMEBUFFER 0x1
+#define SAVE_STATE_FLAG_FIXED_AUDIO 0x2
+
+// the apu keeps different state when it mixes in fixed point, a state only loads into a build like its own
+#ifdef PESTO_GB_FIXED_AUDIO
+#define SAVE_STATE_BUILD_FLAGS SAVE_STATE_FLAG_FIXED_AUDIO
+#else
+#define SAVE_STATE_BUILD_FLAGS 0u
+#endif
+
+struct SaveStateHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    uint32_t rom_checksum;
+    uint32_t flags;
+    char title[16];
+};
+
+// appends fields to a byte buffer, large arrays go in with a single memcpy
+class StateWriter
+{
+public:
+    explicit StateWriter(std::vector<uint8_t>& buffer) : buffer(buffer) {}
+
+    void WriteBytes(const void* data, size_t size)
+    {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + size);
+        memcpy(buffer.data() + offset, data, size);
+    }
+
+    template <class T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&value, sizeof(T));
+    }
+
+    size_t Size() const { return buffer.size(); }
+    uint8_t* Data() { return buffer.data(); }
+
+private:
+    std::vector<uint8_t>& buffer;
+};
+
+// reads fields back in the same order, running off the end marks the reader failed
+class StateReader
+{
+public:
+    StateReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    void ReadBytes(void* out, size_t count)
+    {
+        if (failed || position + count > size) [[unlikely]]
+        {
+            failed = true;
+            return;
+        }
+
+        memcpy(out, data + position, count);
+        position += count;
+    }
+
+    template <class T>
+    void Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        ReadBytes(&value, sizeof(T));
+    }
+
+    bool Ok() const { return !failed; }
+    bool AtEnd() const { return position == size; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;
+    bool failed = false;
+};
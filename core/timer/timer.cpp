@@ -54,3 +54,15 @@ void Timer::Cycle(uint8_t cycles)
         }
     }
 }
+
+void Timer::SaveState(StateWriter& writer) const
+{
+    writer.Write(this->tima_cycles);
+    writer.Write(this->div_cycles);
+}
+
+void Timer::LoadState(StateReader& reader)
+{
+    reader.Read(this->tima_cycles);
+    reader.Read(this->div_cycles);
+}
@@ -20,6 +20,9 @@ public:
 
     void Cycle(uint8_t cycles);
 
+    void SaveState(StateWriter& writer) const;
+    void LoadState(StateReader& reader);
+
 private:
     Memory* memory = nullptr;
 
@@ -0,0 +1,189 @@
+#include "batch.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+#include "../../gameboy.h"
+
+static double batch_now_s()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool is_readable(const std::string& path)
+{
+    std::error_code error;
+    return std::filesystem::is_regular_file(path, error);
+}
+
+bool LoadJobList(const std::string& path, uint32_t default_frames, std::vector<BatchJob>& jobs)
+{
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "Failed to open job list %s\n", path.c_str());
+        return false;
+    }
+
+    char line[1024];
+    int line_number = 0;
+    bool ok = true;
+
+    while (fgets(line, sizeof(line), file))
+    {
+        line_number++;
+
+        if (char* comment = strchr(line, '#'))
+            *comment = '\0';
+
+        char rom[1024];
+        unsigned frames = default_frames;
+
+        const int fields = sscanf(line, "%1023s %u", rom, &frames);
+        if (fields <= 0)
+            continue;
+
+        if (frames == 0)
+        {
+            fprintf(stderr, "%s:%d: frame count must be positive\n", path.c_str(), line_number);
+            ok = false;
+            continue;
+        }
+
+        jobs.push_back({rom, frames});
+    }
+
+    fclose(file);
+    return ok;
+}
+
+BatchResult RunBatchJob(const BatchJob& job, const BatchBootRoms& boot_roms)
+{
+    BatchResult result;
+
+    // a missing file would take the whole process down inside the loaders
+    if (!is_readable(job.rom_path))
+    {
+        result.error = "rom not found";
+        return result;
+    }
+
+    const double start = batch_now_s();
+
+    // jobs running the same title share its mapped rom
+    auto game_boy = std::make_unique<GameBoy>(job.rom_path, GameBoySettings{.map_rom = true});
+
+    const std::string& boot_rom = game_boy->IsCGBGame() && !boot_roms.cgb.empty() ? boot_roms.cgb : boot_roms.dmg;
+    if (!is_readable(boot_rom))
+    {
+        result.error = "boot rom not found";
+        return result;
+    }
+
+    game_boy->LoadBootRom(boot_rom);
+    game_boy->SetAudioMuted(job.mute_audio);
+    game_boy->EnableHashLog(true);
+    game_boy->OnDraw([](uint16_t*) {});
+    game_boy->OnAudio([&result](AudioSample, AudioSample) { result.samples++; });
+    game_boy->OnSerial([&result](uint8_t byte) { result.serial.push_back(static_cast<char>(byte)); });
+
+    for (uint32_t frame = 0; frame < job.frames; frame++)
+        game_boy->TickFrame();
+
+    result.seconds = batch_now_s() - start;
+
+    const std::vector<FrameHash>& frames = game_boy->GetHashLog()->GetEntries();
+
+    result.framebuffer_hash = HASH_LOG_OFFSET;
+    result.audio_hash = HASH_LOG_OFFSET;
+
+    for (const FrameHash& frame : frames)
+    {
+        result.framebuffer_hash = FrameHashLog::Hash(&frame.framebuffer, sizeof(frame.framebuffer), result.framebuffer_hash);
+        result.audio_hash = FrameHashLog::Hash(&frame.audio, sizeof(frame.audio), result.audio_hash);
+    }
+
+    result.draws = static_cast<uint32_t>(frames.size());
+    result.last_frame_hash = frames.empty() ? 0 : frames.back().framebuffer;
+    result.ok = true;
+
+    return result;
+}
+
+void WriteBatchResults(FILE* file, const std::vector<BatchJob>& jobs, const std::vector<BatchResult>& results)
+{
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        const BatchJob& job = jobs[i];
+        const BatchResult& result = results[i];
+
+        if (!result.ok)
+        {
+            fprintf(file, "FAIL %s: %s\n", job.rom_path.c_str(), result.error.c_str());
+            continue;
+        }
+
+        fprintf(file, "ok   %s frames %u draws %u last %016" PRIx64 " video %016" PRIx64 " audio %016" PRIx64
+                      " %.3f s (%.0f fps)\n",
+                job.rom_path.c_str(), job.frames, result.draws, result.last_frame_hash, result.framebuffer_hash,
+                result.audio_hash, result.seconds, job.frames / std::max(result.seconds, 1e-9));
+    }
+}
+
+static void write_json_string(FILE* file, const std::string& value)
+{
+    fputc('"', file);
+    for (const char c : value)
+    {
+        if (c == '"' || c == '\\')
+            fputc('\\', file);
+
+        // serial output is raw bytes, anything outside printable ascii is escaped
+        const auto byte = static_cast<unsigned char>(c);
+        if (byte < 0x20 || byte >= 0x7F)
+            fprintf(file, "\\u%04x", byte);
+        else
+            fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+void WriteBatchJSON(FILE* file, const std::vector<BatchJob>& jobs, const std::vector<BatchResult>& results,
+                    unsigned threads, double wall_seconds)
+{
+    fprintf(file, "{\n  \"threads\": %u,\n  \"wall_seconds\": %.6f,\n  \"jobs\": [\n", threads, wall_seconds);
+
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        const BatchJob& job = jobs[i];
+        const BatchResult& result = results[i];
+
+        fprintf(file, "    {\"rom\": ");
+        write_json_string(file, job.rom_path);
+        fprintf(file, ", \"frames\": %u, \"ok\": %s", job.frames, result.ok ? "true" : "false");
+
+        if (result.ok)
+        {
+            fprintf(file, ", \"draws\": %u, \"samples\": %" PRIu64 ", \"last_frame_hash\": \"%016" PRIx64
+                          "\", \"framebuffer_hash\": \"%016" PRIx64 "\", \"audio_hash\": \"%016" PRIx64
+                          "\", \"seconds\": %.6f",
+                    result.draws, result.samples, result.last_frame_hash, result.framebuffer_hash,
+                    result.audio_hash, result.seconds);
+
+            fprintf(file, ", \"serial\": ");
+            write_json_string(file, result.serial);
+        }
+        else
+        {
+            fprintf(file, ", \"error\": ");
+            write_json_string(file, result.error);
+        }
+
+        fprintf(file, "}%s\n", i + 1 < jobs.size() ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define BATCH_DEFAULT_FRAMES 600
+
+struct BatchJob
+{
+    std::string rom_path;
+    uint32_t frames = BATCH_DEFAULT_FRAMES;
+    // skips sound synthesis, the job reports no samples and its audio hash covers none
+    bool mute_audio = false;
+};
+
+struct BatchBootRoms
+{
+    std::string dmg;
+    std::string cgb;
+};
+
+struct BatchResult
+{
+    bool ok = false;
+    std::string error;
+    uint32_t draws = 0;
+    uint64_t samples = 0;
+    // the last frame on its own and every frame chained, the first catches end states,
+    // the second any difference along the way
+    uint64_t last_frame_hash = 0;
+    uint64_t framebuffer_hash = 0;
+    uint64_t audio_hash = 0;
+    // bytes the rom sent over the link port, test roms print their results there
+    std::string serial;
+    double seconds = 0.0;
+};
+
+// lines are "<rom> [frames]", # starts a comment
+bool LoadJobList(const std::string& path, uint32_t default_frames, std::vector<BatchJob>& jobs);
+
+// runs one emulator instance start to finish, safe to call from many threads at once
+BatchResult RunBatchJob(const BatchJob& job, const BatchBootRoms& boot_roms);
+
+void WriteBatchResults(FILE* file, const std::vector<BatchJob>& jobs, const std::vector<BatchResult>& results);
+void WriteBatchJSON(FILE* file, const std::vector<BatchJob>& jobs, const std::vector<BatchResult>& results,
+                    unsigned threads, double wall_seconds);
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch.h"
+#include "thread_pool.h"
+
+static void print_usage()
+{
+    fprintf(stderr,
+            "usage: pesto_gb_batch <job list> --dmg-boot <path> [--cgb-boot <path>] [--frames <count>]\n"
+            "                      [--threads <count>] [--json <path>] [--mute]\n"
+            "  job list lines are \"<rom> [frames]\", one emulator runs per line\n");
+}
+
+int main(int argc, char** argv)
+{
+    std::string job_list;
+    std::string json_path;
+    BatchBootRoms boot_roms;
+    uint32_t default_frames = BATCH_DEFAULT_FRAMES;
+    unsigned threads = std::thread::hardware_concurrency();
+    bool mute_audio = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--dmg-boot") == 0 && i + 1 < argc)
+            boot_roms.dmg = argv[++i];
+        else if (strcmp(argv[i], "--cgb-boot") == 0 && i + 1 < argc)
+            boot_roms.cgb = argv[++i];
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            default_frames = static_cast<uint32_t>(std::max(atoi(argv[++i]), 1));
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = static_cast<unsigned>(std::max(atoi(argv[++i]), 1));
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json_path = argv[++i];
+        else if (strcmp(argv[i], "--mute") == 0)
+            mute_audio = true;
+        else if (argv[i][0] != '-' && job_list.empty())
+            job_list = argv[i];
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (job_list.empty() || boot_roms.dmg.empty())
+    {
+        print_usage();
+        return 1;
+    }
+
+    std::vector<BatchJob> jobs;
+    if (!LoadJobList(job_list, default_frames, jobs))
+        return 1;
+
+    for (BatchJob& job : jobs)
+        job.mute_audio = mute_audio;
+
+    std::vector<BatchResult> results(jobs.size());
+
+    // the longest jobs go out first so a long one doesn't start last and hold up the batch
+    std::vector<size_t> order(jobs.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return jobs[a].frames > jobs[b].frames; });
+
+    const auto start = std::chrono::steady_clock::now();
+
+    WorkStealingPool pool(threads);
+    for (const size_t index : order)
+    {
+        pool.Submit([&, index] { results[index] = RunBatchJob(jobs[index], boot_roms); });
+    }
+    pool.Wait();
+
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    WriteBatchResults(stdout, jobs, results);
+
+    uint64_t total_frames = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        total_frames += jobs[i].frames;
+        failed += results[i].ok ? 0 : 1;
+    }
+
+    printf("%zu jobs, %zu failed, %u threads, %.3f s, %.0f frames/s total\n", jobs.size(), failed,
+           pool.ThreadCount(), wall_seconds, total_frames / std::max(wall_seconds, 1e-9));
+
+    if (!json_path.empty())
+    {
+        FILE* file = fopen(json_path.c_str(), "w");
+        if (file == nullptr)
+        {
+            fprintf(stderr, "Failed to open %s\n", json_path.c_str());
+            return 1;
+        }
+
+        WriteBatchJSON(file, jobs, results, pool.ThreadCount(), wall_seconds);
+        fclose(file);
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(unsigned thread_count)
+{
+    thread_count = std::max(thread_count, 1u);
+
+    for (unsigned i = 0; i < thread_count; i++)
+        this->queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (unsigned i = 0; i < thread_count; i++)
+        this->threads.emplace_back(&WorkStealingPool::Run, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard lock(this->state_mutex);
+        this->stopping = true;
+    }
+
+    this->work_available.notify_all();
+
+    for (std::thread& thread : this->threads)
+        thread.join();
+}
+
+void WorkStealingPool::Submit(PoolTask task)
+{
+    WorkerQueue& queue = *this->queues[this->next_queue];
+    this->next_queue = (this->next_queue + 1) % this->queues.size();
+
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard lock(this->state_mutex);
+        this->queued++;
+        this->unfinished++;
+    }
+
+    this->work_available.notify_one();
+}
+
+void WorkStealingPool::Wait()
+{
+    std::unique_lock lock(this->state_mutex);
+    this->all_done.wait(lock, [this] { return this->unfinished == 0; });
+}
+
+void WorkStealingPool::Run(unsigned index)
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock(this->state_mutex);
+            this->work_available.wait(lock, [this] { return this->stopping || this->queued > 0; });
+
+            if (this->queued == 0)
+                return;
+
+            this->queued--;
+        }
+
+        // a task was counted, so one is in some queue until this worker takes it
+        PoolTask task;
+        while (!TryPop(index, task) && !TrySteal(index, task))
+            std::this_thread::yield();
+
+        task();
+
+        std::lock_guard lock(this->state_mutex);
+        if (--this->unfinished == 0)
+            this->all_done.notify_all();
+    }
+}
+
+bool WorkStealingPool::TryPop(unsigned index, PoolTask& task)
+{
+    WorkerQueue& queue = *this->queues[index];
+    std::lock_guard lock(queue.mutex);
+
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::TrySteal(unsigned thief, PoolTask& task)
+{
+    for (size_t offset = 1; offset < this->queues.size(); offset++)
+    {
+        WorkerQueue& queue = *this->queues[(thief + offset) % this->queues.size()];
+        std::lock_guard lock(queue.mutex);
+
+        if (queue.tasks.empty())
+            continue;
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    return false;
+}
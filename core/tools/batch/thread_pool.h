@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::function<void()> PoolTask;
+
+// every worker owns a queue and takes from its back, idle workers steal from the front
+// of the others. jobs are whole emulator runs so a lock per queue costs nothing
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(unsigned thread_count);
+    ~WorkStealingPool();
+
+    // tasks are dealt round robin, stealing evens out jobs of different length
+    void Submit(PoolTask task);
+    void Wait();
+
+    unsigned ThreadCount() const { return static_cast<unsigned>(this->threads.size()); }
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<PoolTask> tasks;
+    };
+
+    void Run(unsigned index);
+    bool TryPop(unsigned index, PoolTask& task);
+    bool TrySteal(unsigned thief, PoolTask& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    unsigned next_queue = 0;
+
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    size_t queued = 0;
+    size_t unfinished = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_runner.h"
+#include "../batch/thread_pool.h"
+
+static void print_usage()
+{
+    fprintf(stderr,
+            "usage: pesto_gb_testrunner <rom dir> --dmg-boot <path> [--cgb-boot <path>] [--max-frames <count>]\n"
+            "                           [--threads <count>] [--verbose]\n"
+            "  runs every .gb and .gbc below the directory until it reports a result over serial\n"
+            "  or in cartridge ram, a rom that never does times out\n");
+}
+
+int main(int argc, char** argv)
+{
+    std::string rom_dir;
+    TestRunnerOptions options;
+    unsigned threads = std::thread::hardware_concurrency();
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--dmg-boot") == 0 && i + 1 < argc)
+            options.dmg_boot = argv[++i];
+        else if (strcmp(argv[i], "--cgb-boot") == 0 && i + 1 < argc)
+            options.cgb_boot = argv[++i];
+        else if (strcmp(argv[i], "--max-frames") == 0 && i + 1 < argc)
+            options.max_frames = static_cast<uint32_t>(std::max(atoi(argv[++i]), 1));
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = static_cast<unsigned>(std::max(atoi(argv[++i]), 1));
+        else if (strcmp(argv[i], "--verbose") == 0)
+            verbose = true;
+        else if (argv[i][0] != '-' && rom_dir.empty())
+            rom_dir = argv[i];
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (rom_dir.empty() || options.dmg_boot.empty())
+    {
+        print_usage();
+        return 1;
+    }
+
+    const std::vector<std::string> roms = FindTestRoms(rom_dir);
+    if (roms.empty())
+    {
+        fprintf(stderr, "No test roms found in %s\n", rom_dir.c_str());
+        return 1;
+    }
+
+    std::vector<TestResult> results(roms.size());
+
+    const auto start = std::chrono::steady_clock::now();
+
+    WorkStealingPool pool(threads);
+    for (size_t i = 0; i < roms.size(); i++)
+    {
+        pool.Submit([&, i] { results[i] = RunTestRom(roms[i], options); });
+    }
+    pool.Wait();
+
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t counts[4] = {};
+    for (size_t i = 0; i < roms.size(); i++)
+    {
+        const TestResult& result = results[i];
+        counts[static_cast<int>(result.outcome)]++;
+
+        printf("%s %s frames %u %.3f s", GetOutcomeName(result.outcome), roms[i].c_str(), result.frames, result.seconds);
+        if (!result.message.empty())
+            printf(": %s", result.message.c_str());
+        printf("\n");
+
+        if (verbose && !result.serial.empty())
+            printf("%s\n", result.serial.c_str());
+    }
+
+    printf("%zu roms, %zu passed, %zu failed, %zu timed out, %zu errors, %u threads, %.3f s\n", roms.size(),
+           counts[static_cast<int>(TestOutcome::TEST_PASSED)], counts[static_cast<int>(TestOutcome::TEST_FAILED)],
+           counts[static_cast<int>(TestOutcome::TEST_TIMEOUT)], counts[static_cast<int>(TestOutcome::TEST_ERROR)],
+           pool.ThreadCount(), wall_seconds);
+
+    return counts[static_cast<int>(TestOutcome::TEST_PASSED)] == roms.size() ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+#include "test_runner.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+
+#include "../../gameboy.h"
+
+// mooneye's tests send the fibonacci numbers on success and 0x42 six times on failure
+static constexpr uint8_t mooneye_pass[] = {3, 5, 8, 13, 21, 34};
+static constexpr uint8_t mooneye_fail[] = {0x42, 0x42, 0x42, 0x42, 0x42, 0x42};
+
+static constexpr uint8_t blargg_signature[] = {0xDE, 0xB0, 0x61};
+
+static double test_now_s()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool ends_with(const std::string& text, const uint8_t* pattern, size_t length)
+{
+    return text.size() >= length && std::equal(pattern, pattern + length, text.end() - length,
+                                               [](uint8_t a, char b) { return a == static_cast<uint8_t>(b); });
+}
+
+static std::string last_line(const std::string& text)
+{
+    const size_t end = text.find_last_not_of(" \n\r\t");
+    if (end == std::string::npos)
+        return {};
+
+    const size_t newline = text.find_last_of('\n', end);
+    const size_t start = newline == std::string::npos ? 0 : newline + 1;
+    return text.substr(start, end - start + 1);
+}
+
+std::vector<std::string> FindTestRoms(const std::string& directory)
+{
+    std::vector<std::string> roms;
+    std::error_code error;
+
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+         !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+    {
+        const std::string extension = it->path().extension().string();
+        if (it->is_regular_file(error) && (extension == ".gb" || extension == ".gbc"))
+            roms.push_back(it->path().string());
+    }
+
+    std::sort(roms.begin(), roms.end());
+    return roms;
+}
+
+// the serial patterns are checked first, a rom that prints its result usually mirrors it in memory
+static bool check_serial(const std::string& serial, TestResult& result)
+{
+    if (ends_with(serial, mooneye_pass, sizeof(mooneye_pass)))
+    {
+        result.outcome = TestOutcome::TEST_PASSED;
+        return true;
+    }
+
+    if (ends_with(serial, mooneye_fail, sizeof(mooneye_fail)))
+    {
+        result.outcome = TestOutcome::TEST_FAILED;
+        return true;
+    }
+
+    if (serial.find("Passed") != std::string::npos)
+    {
+        result.outcome = TestOutcome::TEST_PASSED;
+        result.message = last_line(serial);
+        return true;
+    }
+
+    if (serial.find("Failed") != std::string::npos)
+    {
+        result.outcome = TestOutcome::TEST_FAILED;
+        result.message = last_line(serial);
+        return true;
+    }
+
+    return false;
+}
+
+// the status byte is only trusted after it was seen running, ram starts out zeroed
+static bool check_memory(GameBoy& game_boy, bool& seen_running, TestResult& result)
+{
+    for (size_t i = 0; i < sizeof(blargg_signature); i++)
+    {
+        if (game_boy.ReadMemory(TEST_RESULT_SIGNATURE_ADDR + i) != blargg_signature[i])
+            return false;
+    }
+
+    const uint8_t status = game_boy.ReadMemory(TEST_RESULT_STATUS_ADDR);
+    if (status == TEST_STATUS_RUNNING)
+    {
+        seen_running = true;
+        return false;
+    }
+
+    if (!seen_running)
+        return false;
+
+    std::string text;
+    for (uint16_t address = TEST_RESULT_TEXT_ADDR; address < TEST_RESULT_TEXT_ADDR + TEST_RESULT_TEXT_MAX; address++)
+    {
+        const uint8_t c = game_boy.ReadMemory(address);
+        if (c == 0)
+            break;
+
+        text.push_back(static_cast<char>(c));
+    }
+
+    result.outcome = status == 0 ? TestOutcome::TEST_PASSED : TestOutcome::TEST_FAILED;
+    result.message = last_line(text);
+    return true;
+}
+
+TestResult RunTestRom(const std::string& rom_path, const TestRunnerOptions& options)
+{
+    TestResult result;
+
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(rom_path, error))
+    {
+        result.message = "rom not found";
+        return result;
+    }
+
+    const double start = test_now_s();
+
+    auto game_boy = std::make_unique<GameBoy>(rom_path, GameBoySettings{.map_rom = true});
+
+    const std::string& boot_rom = game_boy->IsCGBGame() && !options.cgb_boot.empty() ? options.cgb_boot : options.dmg_boot;
+    if (!std::filesystem::is_regular_file(boot_rom, error))
+    {
+        result.message = "boot rom not found";
+        return result;
+    }
+
+    game_boy->LoadBootRom(boot_rom);
+    game_boy->OnDraw([](uint16_t*) {});
+    // results come over serial or through memory, nothing listens
+    game_boy->SetAudioMuted(true);
+    game_boy->OnSerial([&result](uint8_t byte) { result.serial.push_back(static_cast<char>(byte)); });
+
+    bool seen_running = false;
+    result.outcome = TestOutcome::TEST_TIMEOUT;
+
+    while (result.frames < options.max_frames)
+    {
+        game_boy->TickFrame();
+        result.frames++;
+
+        if (check_serial(result.serial, result) || check_memory(*game_boy, seen_running, result))
+            break;
+    }
+
+    if (result.outcome == TestOutcome::TEST_TIMEOUT)
+        result.message = last_line(result.serial);
+
+    result.seconds = test_now_s() - start;
+    return result;
+}
+
+const char* GetOutcomeName(TestOutcome outcome)
+{
+    switch (outcome)
+    {
+    case TestOutcome::TEST_PASSED: return "PASS";
+    case TestOutcome::TEST_FAILED: return "FAIL";
+    case TestOutcome::TEST_TIMEOUT: return "TIME";
+    case TestOutcome::TEST_ERROR: return "ERR ";
+    default: return "?";
+    }
+}
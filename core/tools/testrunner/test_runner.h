@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define TEST_DEFAULT_MAX_FRAMES 7200
+
+// blargg's tests keep their state in cartridge ram behind a signature
+#define TEST_RESULT_STATUS_ADDR 0xA000
+#define TEST_RESULT_SIGNATURE_ADDR 0xA001
+#define TEST_RESULT_TEXT_ADDR 0xA004
+#define TEST_RESULT_TEXT_MAX 512
+#define TEST_STATUS_RUNNING 0x80
+
+enum class TestOutcome
+{
+    TEST_PASSED,
+    TEST_FAILED,
+    TEST_TIMEOUT,
+    TEST_ERROR
+};
+
+struct TestRunnerOptions
+{
+    std::string dmg_boot;
+    std::string cgb_boot;
+    uint32_t max_frames = TEST_DEFAULT_MAX_FRAMES;
+};
+
+struct TestResult
+{
+    TestOutcome outcome = TestOutcome::TEST_ERROR;
+    // the last line the rom printed, or why it couldn't run
+    std::string message;
+    std::string serial;
+    uint32_t frames = 0;
+    double seconds = 0.0;
+};
+
+// every .gb and .gbc file below directory, sorted so runs list in the same order
+std::vector<std::string> FindTestRoms(const std::string& directory);
+
+// runs until the rom reports a result over serial or in memory, or max_frames pass.
+// safe to call from many threads at once
+TestResult RunTestRom(const std::string& rom_path, const TestRunnerOptions& options);
+
+const char* GetOutcomeName(TestOutcome outcome);
@@ -0,0 +1,167 @@
+#include "bench.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+static int64_t bench_now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool parse_button(const std::string& name, InputButton& button)
+{
+    static const std::pair<const char*, InputButton> buttons[] = {
+        { "a", InputButton::BUTTON_A },
+        { "b", InputButton::BUTTON_B },
+        { "start", InputButton::BUTTON_START },
+        { "select", InputButton::BUTTON_SELECT },
+        { "up", InputButton::BUTTON_UP },
+        { "down", InputButton::BUTTON_DOWN },
+        { "left", InputButton::BUTTON_LEFT },
+        { "right", InputButton::BUTTON_RIGHT },
+    };
+
+    for (const auto& [button_name, value] : buttons)
+    {
+        if (name == button_name)
+        {
+            button = value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool LoadInputScript(const std::string& path, std::vector<InputScriptEvent>& events)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        fprintf(stderr, "Failed to open input script %s\n", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+
+    while (std::getline(file, line))
+    {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream stream(line);
+        std::string action, button_name;
+        InputScriptEvent event = {};
+
+        if (!(stream >> event.frame))
+            continue;
+
+        if (!(stream >> action >> button_name) || (action != "press" && action != "release") ||
+            !parse_button(button_name, event.button))
+        {
+            fprintf(stderr, "Invalid input script line %d: %s\n", line_number, line.c_str());
+            return false;
+        }
+
+        event.pressed = action == "press";
+        events.push_back(event);
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const InputScriptEvent& a, const InputScriptEvent& b)
+    {
+        return a.frame < b.frame;
+    });
+
+    return true;
+}
+
+int RunBenchmark(GameBoy& game_boy, const BenchOptions& options)
+{
+    uint64_t framebuffer_hash = HASH_LOG_OFFSET;
+    uint64_t audio_hash = HASH_LOG_OFFSET;
+    uint64_t draw_count = 0;
+    uint64_t sample_count = 0;
+    int64_t draw_ns = 0;
+
+    game_boy.OnDraw([&](uint16_t* data)
+    {
+        const int64_t start = bench_now_ns();
+        framebuffer_hash = FrameHashLog::Hash(data, SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t), framebuffer_hash);
+        draw_count++;
+        draw_ns += bench_now_ns() - start;
+    });
+
+    game_boy.OnAudio([&](AudioSample left, AudioSample right)
+    {
+        const AudioSample samples[2] = { left, right };
+        audio_hash = FrameHashLog::Hash(samples, sizeof(samples), audio_hash);
+        sample_count++;
+    });
+
+    size_t next_event = 0;
+    int64_t min_frame_ns = INT64_MAX;
+    int64_t max_frame_ns = 0;
+
+    game_boy.ResetStats();
+    game_boy.EnableExecutionProfile(options.hot_spots);
+    GameBoyStats last_stats = game_boy.GetStats();
+
+    const int64_t bench_start = bench_now_ns();
+
+    for (uint32_t frame = 0; frame < options.frames; frame++)
+    {
+        for (; next_event < options.input_script.size() && options.input_script[next_event].frame <= frame; next_event++)
+        {
+            const InputScriptEvent& event = options.input_script[next_event];
+            if (event.pressed)
+                game_boy.PressButton(event.button);
+            else
+                game_boy.ReleaseButton(event.button);
+        }
+
+        const int64_t frame_start = bench_now_ns();
+        game_boy.TickFrame();
+        const int64_t frame_ns = bench_now_ns() - frame_start;
+
+        min_frame_ns = std::min(min_frame_ns, frame_ns);
+        max_frame_ns = std::max(max_frame_ns, frame_ns);
+
+        if (options.frame_stats && GameBoyStats::ENABLED)
+        {
+            const GameBoyStats& stats = game_boy.GetStats();
+            printf("frame %u: ", frame);
+            stats.Since(last_stats).PrintFrame(stdout);
+            last_stats = stats;
+        }
+    }
+
+    const int64_t total_ns = std::max<int64_t>(bench_now_ns() - bench_start, 1);
+    const double total_s = total_ns / 1e9;
+    const double emulated_s = options.frames / FRAMES_PER_SECOND;
+    const double fps = options.frames / total_s;
+
+    printf("frames:       %u (%.2f s emulated) in %.3f s\n", options.frames, emulated_s, total_s);
+    printf("emulated fps: %.1f\n", fps);
+    printf("speed:        %.2fx real time\n", fps / FRAMES_PER_SECOND);
+    printf("frame time:   min %.3f ms, avg %.3f ms, max %.3f ms\n",
+           min_frame_ns / 1e6, total_ns / 1e6 / std::max(options.frames, 1u), max_frame_ns / 1e6);
+
+    printf("time per subsystem:\n");
+    printf("  emulation   %8.3f s %5.1f%%\n", (total_ns - draw_ns) / 1e9, 100.0 * (total_ns - draw_ns) / total_ns);
+    printf("  draw        %8.3f s %5.1f%%\n", draw_ns / 1e9, 100.0 * draw_ns / total_ns);
+
+    game_boy.GetStats().Print(stdout);
+
+    if (const ExecutionProfile* profile = game_boy.GetExecutionProfile())
+        profile->PrintReport(stdout);
+
+    printf("draws:        %llu, samples: %llu\n",
+           static_cast<unsigned long long>(draw_count), static_cast<unsigned long long>(sample_count));
+    printf("hashes:       framebuffer %016llx, audio %016llx\n",
+           static_cast<unsigned long long>(framebuffer_hash), static_cast<unsigned long long>(audio_hash));
+
+    return 0;
+}
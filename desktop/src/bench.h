@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "core/gameboy.h"
+
+struct InputScriptEvent
+{
+    uint32_t frame;
+    InputButton button;
+    bool pressed;
+};
+
+struct BenchOptions
+{
+    uint32_t frames = 3600;
+    bool frame_stats = false;
+    bool hot_spots = false;
+    std::vector<InputScriptEvent> input_script;
+};
+
+// script lines are "<frame> <press|release> <button>", # starts a comment
+bool LoadInputScript(const std::string& path, std::vector<InputScriptEvent>& events);
+
+// runs the emulator uncapped without presenting anything and prints timing
+int RunBenchmark(GameBoy& game_boy, const BenchOptions& options);
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <filesystem>
@@ -5,6 +6,7 @@
 #include "core/gameboy.h"
 #include "sdl/display.h"
 #include "sdl/audio.h"
+#include "bench.h"
 
 #include "argparse/argparse.hpp"
 
@@ -29,6 +31,72 @@ int main(int argc, char** argv)
     arguments.add_argument("--cgb-bootrom")
         .help("The path for your gameboy color boot rom file.");
 
+    arguments.add_argument("--scale")
+        .help("Window scale factor.")
+        .default_value(Display::SCALE)
+        .scan<'i', int>();
+
+    arguments.add_argument("--no-grid")
+        .help("Start with the pixel grid effect disabled, toggle it with G.")
+        .flag();
+
+    arguments.add_argument("--rewind-mb")
+        .help("Memory kept for rewind history, hold backspace to rewind. 0 turns it off.")
+        .default_value(16)
+        .scan<'i', int>();
+
+    arguments.add_argument("--rewind-interval")
+        .help("Frames between rewind snapshots, also how far each rewind step goes back.")
+        .default_value(REWIND_DEFAULT_INTERVAL)
+        .scan<'i', int>();
+
+    arguments.add_argument("--sample-rate")
+        .help("Audio output rate in Hz.")
+        .default_value(Audio::SAMPLE_RATE)
+        .scan<'i', int>();
+
+    arguments.add_argument("--run-ahead")
+        .help("Show the frame this many frames ahead to cut input latency, costs one extra frame of emulation each.")
+        .default_value(0)
+        .scan<'i', int>();
+
+    arguments.add_argument("--record-movie")
+        .help("Record button presses with their emulated cycle to this file.");
+
+    arguments.add_argument("--play-movie")
+        .help("Replay a recorded movie, keyboard input is ignored while it plays.");
+
+    arguments.add_argument("--hash-log")
+        .help("Write a framebuffer and audio hash for every frame to this file.");
+
+    arguments.add_argument("--latency")
+        .help("Time key presses until the screen changes and print the histograms on exit.")
+        .flag();
+
+    arguments.add_argument("--bench", "--headless")
+        .help("Run without a window, audio or frame pacing and print timing.")
+        .flag();
+
+    arguments.add_argument("--frames")
+        .help("Number of frames to run in benchmark mode.")
+        .default_value(3600)
+        .scan<'i', int>();
+
+    arguments.add_argument("--frame-stats")
+        .help("Print core stats for every frame in benchmark mode, needs a PESTO_GB_PROFILE build.")
+        .flag();
+
+    arguments.add_argument("--hot-spots")
+        .help("Print the hottest opcodes and ROM addresses in benchmark mode, needs a PESTO_GB_PROFILE build.")
+        .flag();
+
+    arguments.add_argument("--mute")
+        .help("Skip sound synthesis in benchmark mode, no samples go into the audio hash.")
+        .flag();
+
+    arguments.add_argument("--input-script")
+        .help("Button presses to replay in benchmark mode, one \"<frame> <press|release> <button>\" per line.");
+
     try {
         arguments.parse_args(argc, argv);
     }
@@ -42,8 +110,13 @@ int main(int argc, char** argv)
     }
 
     auto rom_path = arguments.get<std::string>("rom");
+    bool is_bench = arguments.get<bool>("--bench");
 
-    GameBoy game_boy(rom_path);
+    GameBoy game_boy(rom_path, {
+        .threaded_rendering = std::thread::hardware_concurrency() > 1,
+        .map_rom = true,
+        .sample_rate = static_cast<uint32_t>(std::max(arguments.get<int>("--sample-rate"), 0))
+    });
 
     if (auto cgb_boot_path = arguments.present<std::string>("--cgb-bootrom");
         cgb_boot_path.has_value() &&game_boy.IsCGBGame())
@@ -56,35 +129,101 @@ int main(int argc, char** argv)
         game_boy.LoadBootRom(dmg_boot_path);
     }
 
+    game_boy.SetRunAhead(arguments.get<int>("--run-ahead"));
+
+    auto record_movie_path = arguments.present<std::string>("--record-movie");
+    auto play_movie_path = arguments.present<std::string>("--play-movie");
+    auto hash_log_path = arguments.present<std::string>("--hash-log");
+
+    // movies start from a full state including cartridge ram, so this runs after the save is read
+    auto start_movie = [&] {
+        if (play_movie_path.has_value() && !game_boy.PlayMovie(*play_movie_path)) {
+            std::cerr << "Failed to load movie " << *play_movie_path << std::endl;
+            return false;
+        }
+
+        if (record_movie_path.has_value())
+            game_boy.StartMovieRecording();
+
+        game_boy.EnableHashLog(hash_log_path.has_value());
+        return true;
+    };
+
+    auto finish_movie = [&] {
+        if (record_movie_path.has_value() && !game_boy.SaveMovie(*record_movie_path))
+            std::cerr << "Failed to write movie " << *record_movie_path << std::endl;
+
+        if (hash_log_path.has_value() && !game_boy.GetHashLog()->Write(*hash_log_path))
+            std::cerr << "Failed to write hash log " << *hash_log_path << std::endl;
+    };
+
+    if (is_bench)
+    {
+        BenchOptions options;
+        options.frames = std::max(arguments.get<int>("--frames"), 1);
+        options.frame_stats = arguments.get<bool>("--frame-stats");
+        options.hot_spots = arguments.get<bool>("--hot-spots");
+
+        if (auto script_path = arguments.present<std::string>("--input-script");
+            script_path.has_value() && !LoadInputScript(*script_path, options.input_script))
+        {
+            return 1;
+        }
+
+        if (!start_movie())
+            return 1;
+
+        game_boy.SetAudioMuted(arguments.get<bool>("--mute"));
+        const int result = RunBenchmark(game_boy, options);
+        finish_movie();
+        return result;
+    }
+
     std::filesystem::path path(rom_path);
 
+    game_boy.EnableRewind(static_cast<size_t>(std::max(arguments.get<int>("--rewind-mb"), 0)) * 1024 * 1024,
+                          arguments.get<int>("--rewind-interval"));
+
     auto display = Display();
-    if (!display.Initialize(path.filename().string())) {
+    if (!display.Initialize(path.filename().string(), arguments.get<int>("--scale"), !arguments.get<bool>("--no-grid"))) {
         fprintf(stderr, "Failed to initialize display");
         return 1;
     }
 
+    game_boy.EnableLatencyMonitor(arguments.get<bool>("--latency"));
+
     game_boy.OnDraw([&](uint16_t* data)
     {
-        display.Update(data);
+        display.Update(data, game_boy.GetDirtyRows());
+        game_boy.FramePresented();
     });
 
     auto audio = Audio();
-    if (!audio.Initialize()) {
+    if (!audio.Initialize(static_cast<int>(game_boy.GetSampleRate()))) {
         fprintf(stderr, "Failed to initialize audio");
         return 1;
     }
 
-    game_boy.OnAudio([&](float left, float right)
+    game_boy.OnAudio([&](AudioSample left, AudioSample right)
     {
-        audio.PushSample(left, right);
+        audio.PushSample(AudioSampleToFloat(left), AudioSampleToFloat(right));
     });
 
     std::string save_path = (path.parent_path() / (path.stem().string() + ".sav")).string();
     game_boy.ReadSave(save_path.c_str());
 
+    if (!start_movie())
+        return 1;
+
+    std::string state_path = (path.parent_path() / (path.stem().string() + ".state")).string();
+
     std::atomic is_running = true;
     std::atomic is_speedup = false;
+    std::atomic is_rewinding = false;
+
+    // state requests are handled by the game thread between frames
+    std::atomic save_state_requested = false;
+    std::atomic load_state_requested = false;
 
     std::thread game_thread([&]{
 
@@ -103,6 +242,19 @@ int main(int argc, char** argv)
                 frame_start = next_frame;
             }
 
+            if (save_state_requested.exchange(false) && !game_boy.SaveStateFile(state_path))
+                std::cerr << "Failed to write save state " << state_path << std::endl;
+
+            if (load_state_requested.exchange(false) && !game_boy.LoadStateFile(state_path))
+                std::cerr << "Failed to load save state " << state_path << std::endl;
+
+            // one snapshot back per frame, the frame run from it is what gets shown
+            if (is_rewinding)
+                game_boy.Rewind();
+
+            // fast forward would only overrun the audio buffer
+            game_boy.SetAudioMuted(is_speedup);
+
             game_boy.TickFrame();
         }
 
@@ -112,42 +264,58 @@ int main(int argc, char** argv)
     {
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
+            // stamped as it is read, the core lands it as far into a frame as it came in
+            const int64_t event_ns = GameBoy::GetHostTime();
+
             if (event.type == SDL_QUIT) {
                 is_running = false;
                 break;
             }
 
-            if (event.type == SDL_KEYDOWN)
+            // auto-repeat would queue presses for buttons already held
+            if (event.type == SDL_KEYDOWN && !event.key.repeat)
             {
                 switch(event.key.keysym.sym)
                 {
                 case SDLK_UP:
-                    game_boy.PressButton(InputButton::BUTTON_UP);
+                    game_boy.PressButton(InputButton::BUTTON_UP, event_ns);
                     break;
                 case SDLK_DOWN:
-                    game_boy.PressButton(InputButton::BUTTON_DOWN);
+                    game_boy.PressButton(InputButton::BUTTON_DOWN, event_ns);
                     break;
                 case SDLK_LEFT:
-                    game_boy.PressButton(InputButton::BUTTON_LEFT);
+                    game_boy.PressButton(InputButton::BUTTON_LEFT, event_ns);
                     break;
                 case SDLK_RIGHT:
-                    game_boy.PressButton(InputButton::BUTTON_RIGHT);
+                    game_boy.PressButton(InputButton::BUTTON_RIGHT, event_ns);
                     break;
                 case SDLK_x:
-                    game_boy.PressButton(InputButton::BUTTON_A);
+                    game_boy.PressButton(InputButton::BUTTON_A, event_ns);
                     break;
                 case SDLK_z:
-                    game_boy.PressButton(InputButton::BUTTON_B);
+                    game_boy.PressButton(InputButton::BUTTON_B, event_ns);
                     break;
                 case SDLK_RETURN:
-                    game_boy.PressButton(InputButton::BUTTON_START);
+                    game_boy.PressButton(InputButton::BUTTON_START, event_ns);
                     break;
                 case SDLK_RSHIFT:
-                    game_boy.PressButton(InputButton::BUTTON_SELECT);
+                    game_boy.PressButton(InputButton::BUTTON_SELECT, event_ns);
                     break;
                 case SDLK_TAB:
                     is_speedup = true;
                     break;
+                case SDLK_BACKSPACE:
+                    is_rewinding = true;
+                    break;
+                case SDLK_g:
+                    display.TogglePixelGrid();
+                    break;
+                case SDLK_F1:
+                    save_state_requested = true;
+                    break;
+                case SDLK_F2:
+                    load_state_requested = true;
+                    break;
                 }
             }
 
@@ -156,39 +324,49 @@ int main(int argc, char** argv)
                 switch(event.key.keysym.sym)
                 {
                 case SDLK_UP:
-                    game_boy.ReleaseButton(InputButton::BUTTON_UP);
+                    game_boy.ReleaseButton(InputButton::BUTTON_UP, event_ns);
                     break;
                 case SDLK_DOWN:
-                    game_boy.ReleaseButton(InputButton::BUTTON_DOWN);
+                    game_boy.ReleaseButton(InputButton::BUTTON_DOWN, event_ns);
                     break;
                 case SDLK_LEFT:
-                    game_boy.ReleaseButton(InputButton::BUTTON_LEFT);
+                    game_boy.ReleaseButton(InputButton::BUTTON_LEFT, event_ns);
                     break;
                 case SDLK_RIGHT:
-                    game_boy.ReleaseButton(InputButton::BUTTON_RIGHT);
+                    game_boy.ReleaseButton(InputButton::BUTTON_RIGHT, event_ns);
                     break;
                 case SDLK_x:
-                    game_boy.ReleaseButton(InputButton::BUTTON_A);
+                    game_boy.ReleaseButton(InputButton::BUTTON_A, event_ns);
                     break;
                 case SDLK_z:
-                    game_boy.ReleaseButton(InputButton::BUTTON_B);
+                    game_boy.ReleaseButton(InputButton::BUTTON_B, event_ns);
                     break;
                 case SDLK_RETURN:
-                    game_boy.ReleaseButton(InputButton::BUTTON_START);
+                    game_boy.ReleaseButton(InputButton::BUTTON_START, event_ns);
                     break;
                 case SDLK_RSHIFT:
-                    game_boy.ReleaseButton(InputButton::BUTTON_SELECT);
+                    game_boy.ReleaseButton(InputButton::BUTTON_SELECT, event_ns);
                     break;
                 case SDLK_TAB:
                     is_speedup = false;
                     break;
+                case SDLK_BACKSPACE:
+                    is_rewinding = false;
+                    break;
                 }
             }
         }
     }
 
-    game_boy.WriteSave(save_path.c_str());
     game_thread.join();
+    finish_movie();
+
+    if (const LatencyMonitor* latency = game_boy.GetLatencyMonitor())
+        latency->Print(stdout);
+
+    // a played back movie ran on its own copy of the cartridge ram, keep the player's save
+    if (!play_movie_path.has_value())
+        game_boy.WriteSave(save_path.c_str());
     audio.Close();
 
     return 0;
@@ -12,7 +12,7 @@ Audio::~Audio()
     Close();
 }
 
-bool Audio::Initialize()
+bool Audio::Initialize(int sample_rate)
 {
     if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
         return false;
@@ -21,7 +21,7 @@ bool Audio::Initialize()
     SDL_AudioSpec desired_spec;
     SDL_zero(desired_spec);
 
-    desired_spec.freq = SAMPLE_RATE;
+    desired_spec.freq = sample_rate;
     desired_spec.format = AUDIO_F32SYS;
     desired_spec.channels = CHANNELS;
     desired_spec.samples = BUFFER_SIZE;
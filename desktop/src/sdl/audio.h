@@ -7,14 +7,15 @@
 
 class Audio {
 public:
-    static constexpr int SAMPLE_RATE = 44100;
+    // what most mixers run at, anything else gets resampled again on the way out
+    static constexpr int SAMPLE_RATE = 48000;
     static constexpr int BUFFER_SIZE = 2048;
     static constexpr int CHANNELS = 2;
 
     Audio();
     ~Audio();
 
-    bool Initialize();
+    bool Initialize(int sample_rate);
     void Close();
 
     void PushSample(float left, float right);
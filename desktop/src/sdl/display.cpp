@@ -1,24 +1,32 @@
 #include "display.h"
 #include <cstring>
 #include <string>
+#include <vector>
 
 static constexpr uint32_t FPS_WINDOW_MS = 1000;
 
-Display::Display() : window(nullptr), renderer(nullptr), texture(nullptr) {}
+// matches the old per line fill, 0x101010 at alpha 0x18, crossings get blended twice
+static constexpr uint32_t GRID_LINE_COLOR = 0x18101010;
+static constexpr uint32_t GRID_CROSS_COLOR = 0x2E101010;
+
+Display::Display() : window(nullptr), renderer(nullptr), texture(nullptr), grid_texture(nullptr) {}
 
 Display::~Display() {
+    if (grid_texture) SDL_DestroyTexture(grid_texture);
     if (texture) SDL_DestroyTexture(texture);
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
     SDL_Quit();
 }
 
-bool Display::Initialize(std::string rom_name) {
+bool Display::Initialize(std::string rom_name, int scale, bool pixel_grid) {
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         return false;
     }
 
     this->rom_name = rom_name;
+    this->scale = scale > 0 ? scale : 1;
+    this->show_grid = pixel_grid;
 
     char name_buf[64];
     snprintf(name_buf, 64, "Pesto GB - %s", rom_name.c_str());
@@ -27,8 +35,8 @@ bool Display::Initialize(std::string rom_name) {
         name_buf,
         SDL_WINDOWPOS_CENTERED,
         SDL_WINDOWPOS_CENTERED,
-        WIDTH * SCALE,
-        HEIGHT * SCALE,
+        WIDTH * this->scale,
+        HEIGHT * this->scale,
         SDL_WINDOW_SHOWN
     );
 
@@ -53,6 +61,10 @@ bool Display::Initialize(std::string rom_name) {
         return false;
     }
 
+    if (!CreateGridTexture()) {
+        return false;
+    }
+
     fps_window_start = SDL_GetTicks();
 
     Clear();
@@ -60,6 +72,55 @@ bool Display::Initialize(std::string rom_name) {
     return true;
 }
 
+bool Display::CreateGridTexture() {
+    // a grid needs at least one pixel of cell left over
+    if (scale < 2) {
+        return true;
+    }
+
+    const int grid_width = WIDTH * scale;
+    const int grid_height = HEIGHT * scale;
+
+    grid_texture = SDL_CreateTexture(
+        renderer,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_TEXTUREACCESS_STATIC,
+        grid_width,
+        grid_height
+    );
+
+    if (!grid_texture) {
+        return false;
+    }
+
+    std::vector<uint32_t> pixels(grid_width * grid_height, 0);
+
+    for (int y = 0; y < grid_height; y++) {
+        bool row_line = (y + 1) % scale == 0 && y != grid_height - 1;
+
+        for (int x = 0; x < grid_width; x++) {
+            bool column_line = (x + 1) % scale == 0 && x != grid_width - 1;
+
+            if (row_line && column_line) {
+                pixels[y * grid_width + x] = GRID_CROSS_COLOR;
+            }
+            else if (row_line || column_line) {
+                pixels[y * grid_width + x] = GRID_LINE_COLOR;
+            }
+        }
+    }
+
+    SDL_UpdateTexture(grid_texture, nullptr, pixels.data(), grid_width * sizeof(uint32_t));
+    SDL_SetTextureBlendMode(grid_texture, SDL_BLENDMODE_BLEND);
+
+    return true;
+}
+
+void Display::TogglePixelGrid() {
+    show_grid = !show_grid;
+    force_present = true;
+}
+
 void Display::UpdateFPS() {
     fps_frame_count++;
 
@@ -78,33 +139,37 @@ void Display::UpdateFPS() {
     }
 }
 
-void Display::Update(uint16_t* pixels) {
-    uint32_t framebuffer[WIDTH * HEIGHT] = {};
-
-    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+void Display::ConvertRows(const uint16_t* pixels, int begin, int end) {
+    for (int i = begin * WIDTH; i < end * WIDTH; i++) {
         uint16_t color = pixels[i];
         uint8_t r = (color & 0x1F) << 3;
         uint8_t g = ((color >> 5) & 0x1F) << 3;
         uint8_t b = ((color >> 10) & 0x1F) << 3;
         framebuffer[i] = 0xFF << 24 | (r << 16) | (g << 8) | b;
     }
+}
 
-    SDL_UpdateTexture(texture, nullptr, framebuffer, WIDTH * sizeof(uint32_t));
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+void Display::Update(uint16_t* pixels, const DirtyRows& dirty_rows) {
+    // identical frame, keep showing the last one
+    if (!dirty_rows.Any() && !force_present.exchange(false)) {
+        UpdateFPS();
+        return;
+    }
 
-    // pixel grid effect
-    SDL_SetRenderDrawColor(renderer, 0x10, 0x10, 0x10, 0x18);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    int begin = 0, end = 0;
+    while (dirty_rows.NextRange(end, begin, end)) {
+        ConvertRows(pixels, begin, end);
 
-    for (int x = 1; x < WIDTH; x++) {
-        SDL_Rect line = { x * SCALE - 1, 0, 1, HEIGHT * SCALE };
-        SDL_RenderFillRect(renderer, &line);
+        SDL_Rect rows = { 0, begin, WIDTH, end - begin };
+        SDL_UpdateTexture(texture, &rows, framebuffer + begin * WIDTH, WIDTH * sizeof(uint32_t));
     }
 
-    for (int y = 1; y < HEIGHT; y++) {
-        SDL_Rect line = { 0, y * SCALE - 1, WIDTH * SCALE, 1 };
-        SDL_RenderFillRect(renderer, &line);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+
+    // pixel grid effect
+    if (show_grid && grid_texture) {
+        SDL_RenderCopy(renderer, grid_texture, nullptr, nullptr);
     }
 
     SDL_RenderPresent(renderer);
@@ -1,9 +1,12 @@
 #pragma once
+#include <atomic>
 #include <string>
 
 #include <SDL2/SDL.h>
 #include <cstdint>
 
+#include "core/graphics/dirty_rows.h"
+
 class Display {
 public:
     static constexpr int WIDTH = 160;
@@ -13,16 +16,27 @@ public:
     Display();
     ~Display();
 
-    bool Initialize(std::string rom_name);
-    void Update(uint16_t* pixels);
+    bool Initialize(std::string rom_name, int scale = SCALE, bool pixel_grid = true);
+    void Update(uint16_t* pixels, const DirtyRows& dirty_rows);
     void Clear();
 
+    void TogglePixelGrid();
+
 private:
     void UpdateFPS();
+    void ConvertRows(const uint16_t* pixels, int begin, int end);
+    bool CreateGridTexture();
 
     SDL_Window* window;
     SDL_Renderer* renderer;
     SDL_Texture* texture;
+    SDL_Texture* grid_texture;
+
+    int scale = SCALE;
+    std::atomic<bool> show_grid = true;
+    std::atomic<bool> force_present = false;
+
+    uint32_t framebuffer[WIDTH * HEIGHT] = {};
 
     std::string rom_name;
     uint32_t fps_frame_count = 0;
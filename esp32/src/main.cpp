@@ -12,6 +12,8 @@
 #define ROM_PATH "/roms/gold.gbc"
 #define DMG_BOOT_PATH "/roms/dmg_boot.bin"
 #define CGB_BOOT_PATH "/roms/cgb_boot.bin"
+// prints button to screen latency along with the draw rate
+#define MEASURE_INPUT_LATENCY false
 
 static DisplayTask display;
 static AudioTask audio;
@@ -37,7 +39,8 @@ extern "C" void app_main(void)
             GB_COLOR(192, 208, 152),
             GB_COLOR(120, 160, 20),
             GB_COLOR(56, 88, 20),
-        }
+        },
+        .sample_rate = SAMPLE_RATE
     });
 
     if (emulator->IsCGBGame())
@@ -50,16 +53,18 @@ extern "C" void app_main(void)
     }
 
     emu.Init(emulator);
-    display.Init(framebuffer);
+    display.Init(framebuffer, emulator);
     audio.Init();
     input.Init(emulator);
 
-    emulator->OnDraw([](uint16_t*)
+    emulator->EnableLatencyMonitor(MEASURE_INPUT_LATENCY);
+
+    emulator->OnDraw([emulator](uint16_t*)
     {
-        display.Update();
+        display.Update(emulator->GetDirtyRows());
     });
 
-    emulator->OnAudio([](const float left, const float right)
+    emulator->OnAudio([](const AudioSample left, const AudioSample right)
     {
         audio.PushSample(left, right);
     });
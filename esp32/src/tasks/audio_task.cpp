@@ -31,7 +31,7 @@ void AudioTask::Start()
     xTaskCreatePinnedToCore(TaskFunc, "audio", 4096, this, 7, nullptr, 0);
 }
 
-void AudioTask::PushSample(float left, float right)
+void AudioTask::PushSample(AudioSample left, AudioSample right)
 {
     sample_queue.Push(left, right);
 }
@@ -43,11 +43,16 @@ int32_t AudioTask::ScaleSample(float sample)
     return static_cast<int32_t>(static_cast<int16_t>(clamped)) << 16;
 }
 
+int32_t AudioTask::ScaleSample(int16_t sample)
+{
+    return static_cast<int32_t>(sample) << 16;
+}
+
 void AudioTask::Run()
 {
     while (true)
     {
-        float left, right;
+        AudioSample left, right;
 
         if (!sample_queue.Pop(left, right))
         {
@@ -55,6 +60,10 @@ void AudioTask::Run()
             continue;
         }
 
+#ifdef PESTO_GB_FIXED_AUDIO
+        batch[batch_pos] = ScaleSample(left);
+        batch[batch_pos + 1] = ScaleSample(right);
+#else
         const double hp_left = left - hpf_left;
         hpf_left = left - hp_left * HPF_DECAY;
 
@@ -63,6 +72,7 @@ void AudioTask::Run()
 
         batch[batch_pos] = ScaleSample(static_cast<float>(hp_left));
         batch[batch_pos + 1] = ScaleSample(static_cast<float>(hp_right));
+#endif
         batch_pos += 2;
 
         if (batch_pos >= AUDIO_BATCH * 2)
@@ -3,6 +3,7 @@
 #include <cstdint>
 
 #include "task.h"
+#include "core/audio/audio_sample.h"
 #include "driver/i2s_std.h"
 #include "driver/gpio.h"
 
@@ -14,6 +15,7 @@
 #define AUDIO_BATCH 128
 #define AUDIO_MASTER_VOL 1.0f
 
+// the fixed point core blocks dc itself
 #define HPF_DECAY 0.998943
 
 #define SAMPLE_QUEUE_SIZE 2048
@@ -23,8 +25,8 @@ struct SampleQueue
 {
     struct SamplePair
     {
-        float left;
-        float right;
+        AudioSample left;
+        AudioSample right;
     };
 
     alignas(64) std::atomic<uint32_t> write_pos = {0};
@@ -32,7 +34,7 @@ struct SampleQueue
 
     SamplePair buf[SAMPLE_QUEUE_SIZE];
 
-    void Push(const float left, const float right)
+    void Push(const AudioSample left, const AudioSample right)
     {
         const uint32_t cur_write_pos = write_pos.load(std::memory_order_relaxed);
         const uint32_t next = (cur_write_pos + 1) & SAMPLE_QUEUE_MASK;
@@ -43,7 +45,7 @@ struct SampleQueue
         write_pos.store(next, std::memory_order_release);
     }
 
-    bool Pop(float& left, float& right)
+    bool Pop(AudioSample& left, AudioSample& right)
     {
         const uint32_t cur_read_pos = read_pos.load(std::memory_order_relaxed);
         if (cur_read_pos == write_pos.load(std::memory_order_acquire))
@@ -61,13 +63,14 @@ class AudioTask : public Task
 public:
     void Init();
     void Start() override;
-    void PushSample(float left, float right);
+    void PushSample(AudioSample left, AudioSample right);
 
 protected:
     void Run() override;
 
 private:
     static int32_t ScaleSample(float sample);
+    static int32_t ScaleSample(int16_t sample);
 
     SampleQueue sample_queue = {};
     i2s_chan_handle_t i2s_handle = nullptr;
@@ -75,6 +78,8 @@ private:
     int32_t batch[AUDIO_BATCH * 2] = {};
     int batch_pos = 0;
 
+#ifndef PESTO_GB_FIXED_AUDIO
     double hpf_left = 0.0;
     double hpf_right = 0.0;
+#endif
 };
\ No newline at end of file
@@ -15,9 +15,10 @@
 #define ILI9341_PWCTR2 0xC1
 #define ILI9341_VMCTR1 0xC5
 
-void DisplayTask::Init(uint16_t* fb)
+void DisplayTask::Init(uint16_t* fb, GameBoy* gb)
 {
     framebuffer = fb;
+    emulator = gb;
     frame_ready_lock = xSemaphoreCreateBinary();
     LCDInit();
 }
@@ -27,8 +28,14 @@ void DisplayTask::Start()
     xTaskCreatePinnedToCore(TaskFunc, "display", 4096, this, 5, nullptr, 0);
 }
 
-void DisplayTask::Update() const
+void DisplayTask::Update(const DirtyRows& dirty_rows)
 {
+    if (!dirty_rows.Any())
+        return;
+
+    for (int i = 0; i < DIRTY_ROW_WORDS; i++)
+        pending_rows[i].fetch_or(dirty_rows.bits[i], std::memory_order_relaxed);
+
     xSemaphoreGive(frame_ready_lock);
 }
 
@@ -40,12 +47,29 @@ void DisplayTask::Run()
     while (true)
     {
         xSemaphoreTake(frame_ready_lock, portMAX_DELAY);
-        PushFramebuffer(framebuffer);
+
+        DirtyRows dirty_rows;
+        for (int i = 0; i < DIRTY_ROW_WORDS; i++)
+            dirty_rows.bits[i] = pending_rows[i].exchange(0, std::memory_order_relaxed);
+
+        if (!dirty_rows.Any())
+            continue;
+
+        PushFramebuffer(framebuffer, dirty_rows);
+        emulator->FramePresented();
         frames++;
 
         if (xTaskGetTickCount() - last >= pdMS_TO_TICKS(1000))
         {
             printf("Draw FPS: %d\n", frames);
+
+            if (const LatencyMonitor* latency = emulator->GetLatencyMonitor())
+            {
+                const LatencyHistogram& presented = latency->GetHistogram(LATENCY_PRESENTED);
+                printf("Input latency: %llu presses, mean %.1f ms, p95 %.1f ms\n",
+                       static_cast<unsigned long long>(presented.count), presented.MeanMs(), presented.PercentileMs(95.0));
+            }
+
             frames = 0;
             last = xTaskGetTickCount();
         }
@@ -74,18 +98,31 @@ void DisplayTask::BuildScalingMaps()
         mapped_col[x] = static_cast<uint8_t>((x * GB_W) / SCALED_W);
 }
 
-void DisplayTask::PushFramebuffer(const uint16_t* fb)
+void DisplayTask::PushFramebuffer(const uint16_t* fb, const DirtyRows& dirty_rows)
 {
-    for (int y = 0; y < SCALED_H; y++)
+    int y = 0;
+    while (y < SCALED_H)
     {
-        const uint16_t* src = fb + mapped_row[y] * GB_W;
-        uint16_t* dst = dma_buf + y * SCALED_W;
+        if (!dirty_rows.IsDirty(mapped_row[y]))
+        {
+            y++;
+            continue;
+        }
 
-        for (int dx = 0; dx < SCALED_W; dx++)
-            dst[dx] = Rgb555ToRgb565(src[mapped_col[dx]]);
-    }
+        // convert and send one contiguous band of changed lcd rows
+        const int band_start = y;
+        for (; y < SCALED_H && dirty_rows.IsDirty(mapped_row[y]); y++)
+        {
+            const uint16_t* src = fb + mapped_row[y] * GB_W;
+            uint16_t* dst = dma_buf + y * SCALED_W;
 
-    esp_lcd_panel_draw_bitmap(panel_handle, OFF_X, 0, OFF_X + SCALED_W, SCALED_H, dma_buf);
+            for (int dx = 0; dx < SCALED_W; dx++)
+                dst[dx] = Rgb555ToRgb565(src[mapped_col[dx]]);
+        }
+
+        esp_lcd_panel_draw_bitmap(panel_handle, OFF_X, band_start, OFF_X + SCALED_W, y,
+                                  dma_buf + band_start * SCALED_W);
+    }
 }
 
 void DisplayTask::LCDInit()
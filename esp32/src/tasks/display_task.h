@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <cstdint>
 
 #include "task.h"
@@ -32,9 +33,9 @@
 class DisplayTask : public Task
 {
 public:
-    void Init(uint16_t* framebuffer);
+    void Init(uint16_t* framebuffer, GameBoy* emulator);
     void Start() override;
-    void Update() const;
+    void Update(const DirtyRows& dirty_rows);
 
 protected:
     void Run() override;
@@ -42,17 +43,21 @@ protected:
 private:
     void LCDInit();
     void BuildScalingMaps();
-    void PushFramebuffer(const uint16_t* framebuffer);
+    void PushFramebuffer(const uint16_t* framebuffer, const DirtyRows& dirty_rows);
 
     static uint16_t Swap16(uint16_t c);
     static uint16_t Rgb555ToRgb565(uint16_t c);
 
     uint16_t* framebuffer = nullptr;
+    GameBoy* emulator = nullptr;
     SemaphoreHandle_t frame_ready_lock = nullptr;
     esp_lcd_panel_handle_t panel_handle = nullptr;
     esp_lcd_panel_io_handle_t io_handle = nullptr;
     uint16_t* dma_buf = nullptr;
 
+    // rows changed since the last push, merged across frames the task skipped
+    std::atomic<uint32_t> pending_rows[DIRTY_ROW_WORDS] = {};
+
     uint8_t mapped_row[SCALED_H] = {};
     uint8_t mapped_col[SCALED_W] = {};
 };
\ No newline at end of file
@@ -34,6 +34,8 @@ void InputTask::Run()
 
     while (true)
     {
+        const int64_t poll_ns = GameBoy::GetHostTime();
+
         for (int i = 0; i < static_cast<int>(std::size(BUTTON_MAP)); i++)
         {
             const bool is_down = gpio_get_level(BUTTON_MAP[i].pin) == 0;
@@ -41,9 +43,9 @@ void InputTask::Run()
                 continue;
 
             if (is_down)
-                emulator->PressButton(BUTTON_MAP[i].button);
+                emulator->PressButton(BUTTON_MAP[i].button, poll_ns);
             else
-                emulator->ReleaseButton(BUTTON_MAP[i].button);
+                emulator->ReleaseButton(BUTTON_MAP[i].button, poll_ns);
 
             last_state[i] = is_down;
         }